@@ -10,9 +10,16 @@ win32:LIBS += -lws2_32
 
 CONFIG += debug_and_release
 
+# Protocol headers are shared with the robot-side DSDisplay library
+INCLUDEPATH += host
+
 SOURCES += \
+    src/FragmentAssembler.cpp \
+    src/LayoutParser.cpp \
+    src/LinkStats.cpp \
     src/Main.cpp \
     src/MainWindow.cpp \
+    src/PacketReader.cpp \
     src/Settings.cpp \
     src/Util.cpp \
     src/MJPEG/ClientBase.cpp \
@@ -22,16 +29,30 @@ SOURCES += \
     src/MJPEG/VideoStream.cpp \
     src/MJPEG/win32_socketpair.c \
     src/NetWidgets/NetWidget.cpp \
+    src/NetWidgets/CanvasItem.cpp \
     src/NetWidgets/CircleWidget.cpp \
+    src/NetWidgets/ColumnCanvas.cpp \
+    src/NetWidgets/Graph.cpp \
+    src/NetWidgets/GraphPlot.cpp \
     src/NetWidgets/ProgressBar.cpp \
     src/NetWidgets/StatusLight.cpp \
-    src/NetWidgets/Text.cpp
+    src/NetWidgets/Text.cpp \
+    src/NetWidgets/TimeSeries.cpp \
+    src/Telemetry/Reader.cpp \
+    src/Telemetry/Recorder.cpp \
+    src/Telemetry/Replay.cpp
 
 HEADERS  += \
+    host/DSDisplay/Compression.hpp \
+    host/DSDisplay/Protocol.hpp \
+    src/FragmentAssembler.hpp \
+    src/LayoutParser.hpp \
+    src/LinkStats.hpp \
     src/MainWindow.hpp \
+    src/PacketReader.hpp \
+    src/PacketReader.inl \
     src/Settings.hpp \
     src/Util.hpp \
-    src/Util.inl \
     src/MJPEG/ClientBase.hpp \
     src/MJPEG/MjpegClient.hpp \
     src/MJPEG/mjpeg_sck.hpp \
@@ -40,10 +61,19 @@ HEADERS  += \
     src/MJPEG/win32_socketpair.h \
     src/MJPEG/WindowCallbacks.hpp \
     src/NetWidgets/NetWidget.hpp \
+    src/NetWidgets/CanvasItem.hpp \
     src/NetWidgets/CircleWidget.hpp \
+    src/NetWidgets/ColumnCanvas.hpp \
+    src/NetWidgets/Graph.hpp \
+    src/NetWidgets/GraphPlot.hpp \
     src/NetWidgets/ProgressBar.hpp \
     src/NetWidgets/StatusLight.hpp \
-    src/NetWidgets/Text.hpp
+    src/NetWidgets/Text.hpp \
+    src/NetWidgets/TimeSeries.hpp \
+    src/Telemetry/Reader.hpp \
+    src/Telemetry/Recorder.hpp \
+    src/Telemetry/Replay.hpp \
+    src/Telemetry/TelemetryFormat.hpp
 
 RESOURCES += \
     DriverStationDisplay.qrc
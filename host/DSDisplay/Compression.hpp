@@ -0,0 +1,180 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <cstring>
+#include <vector>
+
+/**
+ * Small LZ77 codec used to shrink large transfers such as GUISettings.txt
+ *
+ * The stream is a series of sequences. Each starts with a token byte whose
+ * high nibble is the literal count and whose low nibble is the match length
+ * minus four. A nibble of 15 means more length bytes follow, each adding up
+ * to 255, until one is less than 255. The literals come next, then a little
+ * endian uint16 offset back into the output and the match length bytes. The
+ * final sequence has literals only.
+ *
+ * It favors being dependency-free and simple over compression ratio, which is
+ * plenty for the repetitive text it's used on.
+ */
+namespace Compression {
+
+constexpr size_t kMinMatch = 4;
+constexpr size_t kMaxOffset = 65535;
+constexpr int kHashBits = 12;
+
+namespace detail {
+
+inline uint32_t read32(const char* data) {
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+inline void writeLength(std::vector<char>& out, size_t length) {
+    while (length >= 255) {
+        out.push_back(static_cast<char>(255));
+        length -= 255;
+    }
+    out.push_back(static_cast<char>(length));
+}
+
+inline bool readLength(const uint8_t*& in, const uint8_t* end,
+                       size_t& length) {
+    uint8_t byte;
+    do {
+        if (in == end) {
+            return false;
+        }
+        byte = *in++;
+        length += byte;
+    } while (byte == 255);
+
+    return true;
+}
+
+inline void writeSequence(std::vector<char>& out, const char* literals,
+                          size_t literalCount, size_t offset,
+                          size_t matchLength) {
+    size_t matchCode = matchLength == 0 ? 0 : matchLength - kMinMatch;
+    uint8_t token = (literalCount < 15 ? literalCount : 15) << 4 |
+                    (matchCode < 15 ? matchCode : 15);
+    out.push_back(static_cast<char>(token));
+
+    if (literalCount >= 15) {
+        writeLength(out, literalCount - 15);
+    }
+    out.insert(out.end(), literals, literals + literalCount);
+
+    if (matchLength > 0) {
+        out.push_back(static_cast<char>(offset));
+        out.push_back(static_cast<char>(offset >> 8));
+
+        if (matchCode >= 15) {
+            writeLength(out, matchCode - 15);
+        }
+    }
+}
+
+}  // namespace detail
+
+/**
+ * Returns the compressed form of the given data
+ */
+inline std::vector<char> compress(const char* data, size_t size) {
+    std::vector<char> out;
+    out.reserve(size / 2 + 16);
+
+    // Most recent position at which each hashed four byte sequence was seen
+    std::vector<int64_t> table(1 << kHashBits, -1);
+
+    size_t anchor = 0;
+    size_t pos = 0;
+    while (pos + kMinMatch <= size) {
+        uint32_t sequence = detail::read32(data + pos);
+        uint32_t hash = (sequence * 2654435761u) >> (32 - kHashBits);
+        int64_t candidate = table[hash];
+        table[hash] = pos;
+
+        if (candidate >= 0 && pos - candidate <= kMaxOffset &&
+            detail::read32(data + candidate) == sequence) {
+            size_t length = kMinMatch;
+            while (pos + length < size &&
+                   data[candidate + length] == data[pos + length]) {
+                length++;
+            }
+
+            detail::writeSequence(out, data + anchor, pos - anchor,
+                                  pos - candidate, length);
+            pos += length;
+            anchor = pos;
+        } else {
+            pos++;
+        }
+    }
+
+    detail::writeSequence(out, data + anchor, size - anchor, 0, 0);
+    return out;
+}
+
+/**
+ * Decompresses data into out, which must be exactly the uncompressed size
+ *
+ * @return false if the data is malformed or doesn't fill out exactly
+ */
+inline bool decompress(const char* data, size_t size, char* out,
+                       size_t outSize) {
+    auto in = reinterpret_cast<const uint8_t*>(data);
+    auto end = in + size;
+    size_t outPos = 0;
+
+    while (in < end) {
+        uint8_t token = *in++;
+
+        size_t literalCount = token >> 4;
+        if (literalCount == 15 && !detail::readLength(in, end, literalCount)) {
+            return false;
+        }
+        if (literalCount > static_cast<size_t>(end - in) ||
+            literalCount > outSize - outPos) {
+            return false;
+        }
+        std::memcpy(out + outPos, in, literalCount);
+        in += literalCount;
+        outPos += literalCount;
+
+        // The final sequence has no match
+        if (in == end) {
+            break;
+        }
+
+        if (end - in < 2) {
+            return false;
+        }
+        size_t offset = in[0] | in[1] << 8;
+        in += 2;
+
+        size_t matchLength = token & 0x0f;
+        if (matchLength == 15 && !detail::readLength(in, end, matchLength)) {
+            return false;
+        }
+        matchLength += kMinMatch;
+
+        if (offset == 0 || offset > outPos ||
+            matchLength > outSize - outPos) {
+            return false;
+        }
+
+        // Matches may overlap the bytes they produce, so copy bytewise
+        for (size_t i = 0; i < matchLength; i++, outPos++) {
+            out[outPos] = out[outPos - offset];
+        }
+    }
+
+    return outPos == outSize;
+}
+
+}  // namespace Compression
@@ -2,10 +2,17 @@
 
 #include "DSDisplay/DSDisplay.hpp"
 
+#include <algorithm>
+#include <cstdio>
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <utility>
+
+#include "DSDisplay/Compression.hpp"
+#include "DSDisplay/GuiSettings.hpp"
 
 using namespace std::chrono_literals;
 
@@ -48,79 +55,61 @@ DSDisplay::~DSDisplay() {
     m_recvThread.join();
 }
 
-void DSDisplay::Clear() { m_packet.clear(); }
+void DSDisplay::Clear() {
+    m_packet.clear();
+    m_packetStarted = false;
+}
 
-void DSDisplay::AddData(std::string ID, StatusLight data) {
-    // If packet is empty, add "display\r\n" header to packet
-    if (m_packet.getData() == nullptr) {
-        m_packet << std::string("display\r\n");
-    }
+void DSDisplay::AddData(std::string_view ID, StatusLight data) {
+    AddValue(KeyRef{ID}, data);
+}
 
-    m_packet << static_cast<int8_t>('c');
-    m_packet << ID;
-    m_packet << static_cast<int8_t>(data);
+void DSDisplay::AddData(std::string_view ID, bool data) {
+    AddValue(KeyRef{ID}, data);
 }
 
-void DSDisplay::AddData(std::string ID, bool data) {
-    // If packet is empty, add "display\r\n" header to packet
-    if (m_packet.getData() == nullptr) {
-        m_packet << std::string("display\r\n");
-    }
+void DSDisplay::AddData(std::string_view ID, int8_t data) {
+    AddValue(KeyRef{ID}, data);
+}
 
-    m_packet << static_cast<int8_t>('c');
-    m_packet << ID;
+void DSDisplay::AddData(std::string_view ID, int32_t data) {
+    AddValue(KeyRef{ID}, data);
+}
 
-    if (data == true) {
-        m_packet << static_cast<int8_t>(DSDisplay::active);
-    } else {
-        m_packet << static_cast<int8_t>(DSDisplay::inactive);
-    }
+void DSDisplay::AddData(std::string_view ID, std::string_view data) {
+    AddValue(KeyRef{ID}, data);
 }
 
-void DSDisplay::AddData(std::string ID, int8_t data) {
-    // If packet is empty, add "display\r\n" header to packet
-    if (m_packet.getData() == nullptr) {
-        m_packet << std::string("display\r\n");
-    }
+void DSDisplay::AddData(std::string_view ID, double data) {
+    AddValue(KeyRef{ID}, data);
+}
 
-    m_packet << static_cast<int8_t>('c');
-    m_packet << ID;
-    m_packet << data;
+void DSDisplay::AddData(std::string_view ID, const char* data) {
+    AddValue(KeyRef{ID}, std::string_view(data));
 }
 
-void DSDisplay::AddData(std::string ID, int32_t data) {
-    // If packet is empty, add "display\r\n" header to packet
-    if (m_packet.getData() == nullptr) {
-        m_packet << std::string("display\r\n");
-    }
+void DSDisplay::Set(KeyHandle<StatusLight> handle, StatusLight data) {
+    AddValue(KeyRef{{}, handle.m_index}, data);
+}
 
-    m_packet << static_cast<int8_t>('i');
-    m_packet << ID;
-    m_packet << data;
+void DSDisplay::Set(KeyHandle<bool> handle, bool data) {
+    AddValue(KeyRef{{}, handle.m_index}, data);
 }
 
-void DSDisplay::AddData(std::string ID, std::string data) {
-    // If packet is empty, add "display\r\n" header to packet
-    if (m_packet.getData() == nullptr) {
-        m_packet << std::string("display\r\n");
-    }
+void DSDisplay::Set(KeyHandle<int8_t> handle, int8_t data) {
+    AddValue(KeyRef{{}, handle.m_index}, data);
+}
 
-    m_packet << static_cast<int8_t>('s');
-    m_packet << ID;
-    m_packet << data;
+void DSDisplay::Set(KeyHandle<int32_t> handle, int32_t data) {
+    AddValue(KeyRef{{}, handle.m_index}, data);
 }
 
-void DSDisplay::AddData(std::string ID, double data) {
-    // If packet is empty, add "display\r\n" header to packet
-    if (m_packet.getData() == nullptr) {
-        // doubles are converted to strings because VxWorks messes up floating
-        // point values over the network.
-        m_packet << std::string("display\r\n");
-    }
+void DSDisplay::Set(KeyHandle<std::string> handle, std::string_view data) {
+    AddValue(KeyRef{{}, handle.m_index}, data);
+}
 
-    m_packet << static_cast<int8_t>('s');
-    m_packet << ID;
-    m_packet << std::to_string(data);
+void DSDisplay::Set(KeyHandle<double> handle, double data) {
+    AddValue(KeyRef{{}, handle.m_index}, data);
 }
 
 void DSDisplay::SendToDS() {
@@ -134,11 +123,33 @@ void DSDisplay::SendToDS() {
     }
 
     if (dsIP != 0) {
+        if (!m_packetStarted) {
+            StartPacket();
+        }
+
+        // Version 2 packets are built from the key slots at send time
+        if (m_packetVersion >= Protocol::kVersion2) {
+            AppendSlots();
+        }
+
+        m_bandwidth.bytesSent += m_packet.getDataSize();
         m_socket.send(m_packet, dsIP, dsPort);
         Clear();
     }
 }
 
+void DSDisplay::SetDeltaMode(bool enable) { m_deltaMode = enable; }
+
+void DSDisplay::SetKeyframeInterval(std::chrono::milliseconds interval) {
+    m_keyframeInterval = interval;
+}
+
+void DSDisplay::RequestKeyframe() { m_keyframeRequested = true; }
+
+DSDisplay::BandwidthStats DSDisplay::GetBandwidthStats() const {
+    return m_bandwidth;
+}
+
 void DSDisplay::AddAutoMethod(std::string methodName,
                               std::function<void()> initFunc,
                               std::function<void()> periodicFunc) {
@@ -161,74 +172,544 @@ void DSDisplay::ExecAutonomousPeriodic() {
     std::get<2>(m_autonModes[m_curAutonMode])();
 }
 
+void DSDisplay::StartPacket() {
+    auto prevKeys = m_packetKeys;
+
+    {
+        /* Snapshot the connection state so a reconnect halfway through
+         * building the packet can't mix two encodings
+         */
+        std::lock_guard<std::mutex> lock(m_ipMutex);
+        m_packetVersion = m_dsVersion;
+        m_packetKeys = m_keyIds;
+    }
+
+    // A new key table invalidates every slot and handle
+    if (m_packetKeys != prevKeys) {
+        m_slots.assign(m_packetKeys->keys.size(), Slot{});
+        m_dirtySlots.clear();
+        m_slotsSize = 0;
+        m_keyframeRequested = true;
+
+        ResolveHandles();
+    }
+
+    if (m_packetVersion < Protocol::kVersion2) {
+        AppendHeader(m_packet, m_packetVersion, Protocol::Opcode::Display);
+    }
+
+    m_packetStarted = true;
+}
+
+size_t DSDisplay::AddHandle(std::string_view ID) {
+    m_handles.emplace_back();
+    m_handles.back().name = ID;
+
+    // Handles registered later are resolved against the current table
+    if (m_packetKeys != nullptr) {
+        auto id = m_packetKeys->ids.find(ID);
+        if (id != m_packetKeys->ids.end()) {
+            m_handles.back().id = id->second;
+        }
+    }
+
+    return m_handles.size() - 1;
+}
+
+void DSDisplay::ResolveHandles() {
+    for (auto& handle : m_handles) {
+        auto id = m_packetKeys->ids.find(handle.name);
+        if (id != m_packetKeys->ids.end()) {
+            handle.id = id->second;
+        } else {
+            handle.id = kNoKeyId;
+        }
+    }
+}
+
+void DSDisplay::AddValue(const KeyRef& key, StatusLight data) {
+    char value = data;
+    AddEntry(Protocol::ValueType::Char, key, &value, sizeof(value));
+}
+
+void DSDisplay::AddValue(const KeyRef& key, bool data) {
+    char value = data ? DSDisplay::active : DSDisplay::inactive;
+    AddEntry(Protocol::ValueType::Char, key, &value, sizeof(value));
+}
+
+void DSDisplay::AddValue(const KeyRef& key, int8_t data) {
+    char value = data;
+    AddEntry(Protocol::ValueType::Char, key, &value, sizeof(value));
+}
+
+void DSDisplay::AddValue(const KeyRef& key, int32_t data) {
+    char value[sizeof(data)];
+    Protocol::writeU32(value, data);
+    AddEntry(Protocol::ValueType::Int32, key, value, sizeof(value));
+}
+
+void DSDisplay::AddValue(const KeyRef& key, std::string_view data) {
+    AddEntry(Protocol::ValueType::String, key, data.data(), data.size());
+}
+
+void DSDisplay::AddValue(const KeyRef& key, double data) {
+    if (!m_packetStarted) {
+        StartPacket();
+    }
+
+    // Version 1 displays only understand doubles formatted as strings
+    if (m_packetVersion < Protocol::kVersion2) {
+        // Formatted like std::to_string() without allocating
+        char value[std::numeric_limits<double>::max_exponent10 + 20];
+        int size = std::snprintf(value, sizeof(value), "%f", data);
+        AddEntry(Protocol::ValueType::String, key, value, size);
+        return;
+    }
+
+    char value[sizeof(data)];
+    Protocol::writeF64(value, data);
+    AddEntry(Protocol::ValueType::Double, key, value, sizeof(value));
+}
+
+void DSDisplay::AddEntry(Protocol::ValueType type, const KeyRef& key,
+                         const char* value, size_t size) {
+    if (!m_packetStarted) {
+        StartPacket();
+    }
+
+    if (m_packetVersion >= Protocol::kVersion2) {
+        // Handles already know their key's ID
+        uint16_t id = kNoKeyId;
+        if (key.handle != kNoHandle) {
+            id = m_handles[key.handle].id;
+        } else {
+            auto it = m_packetKeys->ids.find(key.name);
+            if (it != m_packetKeys->ids.end()) {
+                id = it->second;
+            }
+        }
+
+        // Keys which don't appear in GUISettings.txt have no ID to send
+        if (id == kNoKeyId) {
+            return;
+        }
+
+        auto& slot = m_slots[id];
+        if (!slot.hasValue || slot.type != type ||
+            slot.value.size() != size ||
+            std::memcmp(slot.value.data(), value, size) != 0) {
+            if (slot.hasValue) {
+                m_slotsSize -= EntrySize(slot);
+            }
+            slot.type = type;
+            slot.value.assign(value, size);
+            slot.hasValue = true;
+            m_slotsSize += EntrySize(slot);
+
+            if (!slot.changed) {
+                slot.changed = true;
+                m_dirtySlots.emplace_back(id);
+            }
+        }
+    } else {
+        std::string_view ID = key.name;
+        if (key.handle != kNoHandle) {
+            ID = m_handles[key.handle].name;
+        }
+
+        // Makes room for every field at once
+        m_packet.reserve(m_packet.getDataSize() + sizeof(uint8_t) +
+                         sizeof(uint32_t) + ID.size() + sizeof(uint32_t) +
+                         size);
+
+        char prefix[sizeof(uint8_t) + sizeof(uint32_t)];
+        prefix[0] = static_cast<char>(type);
+        Protocol::writeU32(prefix + 1, ID.size());
+        m_packet.appendUnchecked(prefix, sizeof(prefix));
+        m_packet.appendUnchecked(ID.data(), ID.size());
+
+        if (type == Protocol::ValueType::String) {
+            char length[sizeof(uint32_t)];
+            Protocol::writeU32(length, size);
+            m_packet.appendUnchecked(length, sizeof(length));
+        }
+        m_packet.appendUnchecked(value, size);
+    }
+}
+
+void DSDisplay::SetLayout(const Schema::Description& layout) {
+    std::lock_guard<std::mutex> lock(m_ipMutex);
+    m_layout = layout;
+    m_hasLayout = true;
+}
+
+void DSDisplay::SendRecord(const Schema::Description& layout,
+                           const char* data) {
+    if (!m_packetStarted) {
+        StartPacket();
+    }
+
+    if (m_packetVersion >= Protocol::kVersion4) {
+        uint32_t dsIP;
+        uint16_t dsPort;
+
+        {
+            std::lock_guard<std::mutex> lock(m_ipMutex);
+            dsIP = m_dsIP;
+            dsPort = m_dsPort;
+        }
+
+        /* Every field is in the record, so it's always a keyframe. The fields
+         * are already in wire encoding, so the record is copied as is.
+         */
+        if (dsIP != 0) {
+            AppendSequenceHeader(Protocol::Opcode::Record, Protocol::kKeyframe,
+                                 steady_clock::now());
+            m_packet.append(data, layout.recordSize);
+
+            m_bandwidth.bytesSent += m_packet.getDataSize();
+            m_socket.send(m_packet, dsIP, dsPort);
+        }
+        Clear();
+        return;
+    }
+
+    for (size_t i = 0; i < layout.fieldCount; i++) {
+        const auto& field = layout.fields[i];
+        const char* value = data + field.offset;
+        KeyRef key{field.key};
+
+        switch (field.type) {
+            case Protocol::ValueType::String:
+                AddEntry(field.type, key, value + sizeof(uint32_t),
+                         Protocol::readU32(value));
+                break;
+            case Protocol::ValueType::Double:
+                // Version 1 displays need the double formatted as a string
+                AddValue(key, Protocol::readF64(value));
+                break;
+            default:
+                AddEntry(field.type, key, value, field.size);
+                break;
+        }
+    }
+
+    // Records aren't preceded by Clear(), so nothing is kept if unsent
+    SendToDS();
+    Clear();
+}
+
+void DSDisplay::AppendSequenceHeader(Protocol::Opcode opcode, uint8_t flags,
+                                     steady_clock::time_point time) {
+    AppendHeader(m_packet, m_packetVersion, opcode);
+    m_packet << flags;
+    m_packet << m_sequence++;
+
+    // Lets the display measure interarrival jitter
+    m_packet << static_cast<uint32_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(time -
+                                                              m_startTime)
+            .count());
+}
+
+void DSDisplay::AppendSlots() {
+    auto time = steady_clock::now();
+
+    /* Without delta mode, every packet is a keyframe. Otherwise, only values
+     * which changed since they were last sent are included.
+     */
+    bool keyframe = !m_deltaMode || m_keyframeRequested.exchange(false) ||
+                    time - m_lastKeyframe >= m_keyframeInterval;
+    if (keyframe) {
+        m_lastKeyframe = time;
+    }
+
+    AppendSequenceHeader(Protocol::Opcode::Display,
+                         keyframe ? Protocol::kKeyframe : 0, time);
+
+    // Size the packet would have been if it contained every value
+    size_t fullSize = m_packet.getDataSize() + m_slotsSize;
+
+    // The packet can't be larger than a keyframe, so this is the only check
+    m_packet.reserve(fullSize);
+
+    /* A keyframe walks every slot in ID order. Otherwise, only the slots which
+     * changed are visited, so a delta costs time proportional to the number
+     * of changed values rather than the number of keys.
+     */
+    if (keyframe) {
+        for (size_t id = 0; id < m_slots.size(); id++) {
+            if (m_slots[id].hasValue) {
+                AppendSlot(id);
+            }
+        }
+    } else {
+        for (auto id : m_dirtySlots) {
+            AppendSlot(id);
+        }
+    }
+    m_dirtySlots.clear();
+
+    m_bandwidth.bytesSaved += fullSize - m_packet.getDataSize();
+}
+
+void DSDisplay::AppendSlot(uint16_t id) {
+    auto& slot = m_slots[id];
+
+    // Type, ID, and string length are written together
+    char prefix[sizeof(uint8_t) + sizeof(uint16_t) + sizeof(uint32_t)];
+    size_t prefixSize = sizeof(uint8_t) + sizeof(uint16_t);
+    prefix[0] = static_cast<char>(slot.type);
+    Protocol::writeU16(prefix + 1, id);
+    if (slot.type == Protocol::ValueType::String) {
+        Protocol::writeU32(prefix + prefixSize, slot.value.size());
+        prefixSize += sizeof(uint32_t);
+    }
+
+    m_packet.appendUnchecked(prefix, prefixSize);
+    m_packet.appendUnchecked(slot.value.data(), slot.value.size());
+
+    slot.changed = false;
+}
+
+size_t DSDisplay::EntrySize(const Slot& slot) {
+    size_t size = sizeof(uint8_t) + sizeof(uint16_t) + slot.value.size();
+    if (slot.type == Protocol::ValueType::String) {
+        size += sizeof(uint32_t);
+    }
+
+    return size;
+}
+
+void DSDisplay::AppendRecordLayout(Packet& packet, const KeyTable& keyIds,
+                                   const Schema::Description& layout) {
+    size_t countPos = packet.appendPlaceholder(sizeof(uint16_t));
+
+    uint16_t count = 0;
+    for (size_t i = 0; i < layout.fieldCount; i++) {
+        const auto& field = layout.fields[i];
+
+        auto id = keyIds.ids.find(field.key);
+        if (id == keyIds.ids.end()) {
+            continue;
+        }
+
+        packet << id->second << static_cast<uint8_t>(field.type)
+               << field.offset << field.size;
+        count++;
+    }
+
+    packet.patch(countPos, count);
+}
+
+void DSDisplay::AppendHeader(Packet& packet, uint8_t version,
+                             Protocol::Opcode opcode) {
+    char header[Protocol::kMaxHeaderSize];
+    packet.append(header, Protocol::encodeHeader(header, version, opcode));
+}
+
 void DSDisplay::SendToDS(Packet& packet) {
     // No locking needed here because this function is only used by
     // ReceiveFromDS(). Only other reads of m_dsIP and m_dsPort can occur at
     // this point.
     if (m_dsIP != 0) {
         m_socket.send(packet, m_dsIP, m_dsPort);
-        m_packet.clear();
+        packet.clear();
+    }
+}
+
+void DSDisplay::SendGuiTransfer(const Packet& payload) {
+    auto data = static_cast<const char*>(payload.getData());
+    size_t size = payload.getDataSize();
+
+    m_guiTransferId++;
+    m_guiTransferRawSize = size;
+
+    // Only send the compressed form if it's actually smaller
+    auto compressed = Compression::compress(data, size);
+    if (compressed.size() < size) {
+        m_guiTransfer = std::move(compressed);
+        m_guiTransferFlags = Protocol::kCompressed;
+    } else {
+        m_guiTransfer.assign(data, data + size);
+        m_guiTransferFlags = 0;
+    }
+
+    for (uint16_t i = 0; i < GuiFragmentCount(); i++) {
+        SendGuiFragment(i);
     }
 }
 
+void DSDisplay::SendGuiFragment(uint16_t index) {
+    Protocol::FragmentHeader header;
+    header.transferId = m_guiTransferId;
+    header.index = index;
+    header.count = GuiFragmentCount();
+    header.flags = m_guiTransferFlags;
+    header.transferSize = m_guiTransfer.size();
+    header.rawSize = m_guiTransferRawSize;
+
+    size_t start = index * Protocol::kFragmentSize;
+    size_t length =
+        std::min(Protocol::kFragmentSize, m_guiTransfer.size() - start);
+
+    m_replyPacket.clear();
+    AppendHeader(m_replyPacket, m_dsVersion, Protocol::Opcode::GuiCreate);
+
+    char buf[Protocol::kFragmentHeaderSize];
+    Protocol::encodeFragmentHeader(buf, header);
+    m_replyPacket.append(buf, sizeof(buf));
+    m_replyPacket.append(m_guiTransfer.data() + start, length);
+
+    SendToDS(m_replyPacket);
+}
+
+uint16_t DSDisplay::GuiFragmentCount() const {
+    size_t count = (m_guiTransfer.size() + Protocol::kFragmentSize - 1) /
+                   Protocol::kFragmentSize;
+
+    // An empty transfer is still sent as one empty fragment
+    return count > 0 ? count : 1;
+}
+
 void DSDisplay::ReceiveFromDS() {
     // Send keepalive every 250ms
     auto time = steady_clock::now();
     if (time - m_prevTime > 250ms) {
-        Packet packet;
-        packet << static_cast<std::string>("\r\n");
-        SendToDS(packet);
+        m_replyPacket.clear();
+        AppendHeader(m_replyPacket, m_dsVersion, Protocol::Opcode::KeepAlive);
+        SendToDS(m_replyPacket);
 
         m_prevTime = time;
     }
 
+    size_t pos = 0;
+    Protocol::Header header;
     if (m_socket.receive(m_recvBuffer, 256, m_recvAmount, m_recvIP,
-                         m_recvPort) == UdpSocket::Done) {
-        if (std::strncmp(m_recvBuffer, "connect\r\n", 9) == 0) {
+                         m_recvPort) == UdpSocket::Done &&
+        Protocol::decodeCommand(m_recvBuffer, m_recvAmount, pos, header)) {
+        if (header.opcode == Protocol::Opcode::Connect) {
+            Schema::Description layout;
+            bool hasLayout;
+
+            // Answer in the highest version both ends understand
+            uint8_t version = Protocol::negotiate(header.version);
+
+            /* Published with the version once it's complete, so StartPacket()
+             * never pairs the new version with the old table
+             */
+            auto keyIds = std::make_shared<KeyTable>();
+
             {
                 std::lock_guard<std::mutex> lock(m_ipMutex);
                 m_dsIP = m_recvIP;
                 m_dsPort = m_recvPort;
+
+                layout = m_layout;
+                hasLayout = m_hasLayout;
             }
 
+            // A (re)connected Driver Station has none of the current values
+            m_keyframeRequested = true;
+
             // Send GUI element file to DS
 
             Packet packet;
-            packet << static_cast<std::string>("guiCreate\r\n");
+            if (version < Protocol::kVersion2) {
+                AppendHeader(packet, version, Protocol::Opcode::GuiCreate);
+            }
 
-            // Open the file
+            // Open the file unless a layout replaces it
+            std::ifstream guiFile;
+            if (!hasLayout) {
 #ifdef __FRC_ROBORIO__
-            std::ifstream guiFile("/home/lvuser/GUISettings.txt",
-                                  std::ifstream::binary);
+                guiFile.open("/home/lvuser/GUISettings.txt",
+                             std::ifstream::binary);
 #else
-            std::ifstream guiFile("GUISettings.txt", std::ifstream::binary);
+                guiFile.open("GUISettings.txt", std::ifstream::binary);
 #endif
+            }
 
-            if (guiFile.is_open()) {
-                // Get its length
-                guiFile.seekg(0, guiFile.end);
-                unsigned int fileSize = guiFile.tellg();
-                guiFile.seekg(0, guiFile.beg);
-
-                // Send the length
-                packet << static_cast<uint32_t>(fileSize);
+            if (hasLayout || guiFile.is_open()) {
+                // The file is read straight into the packet after its length
+                size_t lengthPos = packet.appendPlaceholder(sizeof(uint32_t));
+                size_t fileStart = packet.getDataSize();
 
-                // Allocate a buffer for the file
-                auto tempBuf = std::make_unique<char[]>(fileSize);
+                if (hasLayout) {
+                    packet.append(layout.guiSettings.data(),
+                                  layout.guiSettings.size());
+                } else {
+                    char chunk[4096];
+                    while (guiFile.read(chunk, sizeof(chunk)) ||
+                           guiFile.gcount() > 0) {
+                        packet.append(chunk, guiFile.gcount());
+                    }
+                    guiFile.close();
+                }
 
-                // Send the data
-                guiFile.read(tempBuf.get(), fileSize);
-                packet.append(tempBuf.get(), fileSize);
+                uint32_t fileSize = packet.getDataSize() - fileStart;
+                packet.patch(lengthPos, fileSize);
+
+                /* Version 2 displays receive a table of key IDs after the
+                 * file. Display packets then refer to keys by their index in
+                 * this table instead of by name.
+                 */
+                if (version >= Protocol::kVersion2) {
+                    keyIds->keys = GuiSettings::parseKeys(
+                        {static_cast<const char*>(packet.getData()) + fileStart,
+                         fileSize});
+
+                    // The views are made after keys stops growing
+                    const auto& keys = keyIds->keys;
+                    packet << static_cast<uint16_t>(keys.size());
+                    for (size_t i = 0; i < keys.size(); i++) {
+                        packet << keys[i];
+                        keyIds->ids.emplace(keys[i], i);
+                    }
+
+                    // Version 4 displays decode records by these offsets
+                    if (version >= Protocol::kVersion4) {
+                        AppendRecordLayout(
+                            packet, *keyIds,
+                            hasLayout ? layout : Schema::Description{});
+                    }
+                }
+            }
 
-                guiFile.close();
+            {
+                std::lock_guard<std::mutex> lock(m_ipMutex);
+                m_dsVersion = version;
+                m_keyIds = keyIds;
             }
 
-            SendToDS(packet);
+            /* Version 3 displays are only sent the hash of the payload. They
+             * build the GUI from their cache, or ask for the payload with
+             * LayoutMiss if they don't have it.
+             *
+             * Version 2 displays receive the payload in fragments, so the
+             * size of GUISettings.txt isn't limited to one datagram.
+             */
+            if (version >= Protocol::kVersion3) {
+                m_layoutHash = Protocol::layoutHash(
+                    static_cast<const char*>(packet.getData()),
+                    packet.getDataSize());
+                m_layoutPayload = packet;
+
+                packet.clear();
+                AppendHeader(packet, version, Protocol::Opcode::LayoutHash);
+                packet << static_cast<uint32_t>(m_layoutHash >> 32)
+                       << static_cast<uint32_t>(m_layoutHash);
+                SendToDS(packet);
+            } else if (version >= Protocol::kVersion2) {
+                SendGuiTransfer(packet);
+            } else {
+                SendToDS(packet);
+            }
 
             // Send a list of available autonomous modes
             packet.clear();
 
-            packet << static_cast<std::string>("autonList\r\n");
+            AppendHeader(packet, version, Protocol::Opcode::AutonList);
 
             for (unsigned int i = 0; i < m_autonModes.size(); i++) {
                 packet << std::get<0>(m_autonModes[i]);
@@ -239,17 +720,18 @@ void DSDisplay::ReceiveFromDS() {
             // Make sure driver knows which autonomous mode is selected
             packet.clear();
 
-            packet << static_cast<std::string>("autonConfirmed\r\n");
+            AppendHeader(packet, version, Protocol::Opcode::AutonConfirmed);
             packet << std::get<0>(m_autonModes[m_curAutonMode]);
 
             SendToDS(packet);
-        } else if (std::strncmp(m_recvBuffer, "autonSelect\r\n", 13) == 0) {
+        } else if (header.opcode == Protocol::Opcode::AutonSelect &&
+                   pos < m_recvAmount) {
             // Next byte after command is selection choice
-            m_curAutonMode = m_recvBuffer[13];
+            m_curAutonMode = m_recvBuffer[pos];
 
             Packet packet;
 
-            packet << static_cast<std::string>("autonConfirmed\r\n");
+            AppendHeader(packet, m_dsVersion, Protocol::Opcode::AutonConfirmed);
             packet << std::get<0>(m_autonModes[m_curAutonMode]);
 
             // Store newest autonomous choice to file for persistent storage
@@ -277,6 +759,34 @@ void DSDisplay::ReceiveFromDS() {
             }
 
             SendToDS(packet);
+        } else if (header.opcode == Protocol::Opcode::Resync) {
+            // The Driver Station missed a delta, so send everything again
+            m_keyframeRequested = true;
+        } else if (header.opcode == Protocol::Opcode::LayoutMiss &&
+                   pos + sizeof(uint64_t) <= m_recvAmount) {
+            // Misses for an older layout are ignored like old resend requests
+            if (Protocol::readU64(m_recvBuffer + pos) == m_layoutHash) {
+                SendGuiTransfer(m_layoutPayload);
+            }
+        } else if (header.opcode == Protocol::Opcode::GuiResend &&
+                   pos + 2 * sizeof(uint16_t) <= m_recvAmount) {
+            uint16_t transferId = Protocol::readU16(m_recvBuffer + pos);
+            uint16_t count = Protocol::readU16(m_recvBuffer + pos + 2);
+            pos += 2 * sizeof(uint16_t);
+
+            /* Requests for an older transfer are ignored. The Driver Station
+             * receives the current one when it reconnects.
+             */
+            if (transferId == m_guiTransferId) {
+                for (uint16_t i = 0;
+                     i < count && pos + sizeof(uint16_t) <= m_recvAmount;
+                     i++, pos += sizeof(uint16_t)) {
+                    uint16_t index = Protocol::readU16(m_recvBuffer + pos);
+                    if (index < GuiFragmentCount()) {
+                        SendGuiFragment(index);
+                    }
+                }
+            }
         }
     }
 }
@@ -7,13 +7,18 @@
 #include <atomic>
 #include <chrono>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 #include "DSDisplay/Packet.hpp"
+#include "DSDisplay/Protocol.hpp"
+#include "DSDisplay/Schema.hpp"
 #include "DSDisplay/UdpSocket.hpp"
 
 /**
@@ -42,18 +47,118 @@ public:
      */
     void Clear();
 
-    void AddData(std::string ID, StatusLight data);
-    void AddData(std::string ID, bool data);
-    void AddData(std::string ID, int8_t data);
-    void AddData(std::string ID, int32_t data);
-    void AddData(std::string ID, std::string data);
-    void AddData(std::string ID, double data);
+    /**
+     * Adds a value for the given key to the internal packet.
+     *
+     * Keys and strings are copied straight into the packet, so these don't
+     * allocate once the packet and key slots have grown to fit a full update.
+     */
+    void AddData(std::string_view ID, StatusLight data);
+    void AddData(std::string_view ID, bool data);
+    void AddData(std::string_view ID, int8_t data);
+    void AddData(std::string_view ID, int32_t data);
+    void AddData(std::string_view ID, std::string_view data);
+    void AddData(std::string_view ID, double data);
+
+    // Keeps string literals from converting to bool
+    void AddData(std::string_view ID, const char* data);
+
+    /**
+     * Refers to a key registered with RegisterKey(). T is the type of the
+     * values Set() accepts for it.
+     */
+    template <class T>
+    class KeyHandle {
+    private:
+        friend class DSDisplay;
+
+        explicit KeyHandle(size_t index) : m_index(index) {}
+
+        size_t m_index;
+    };
+
+    /**
+     * Registers a key so its value can be set without looking it up by name.
+     *
+     * T must be StatusLight, bool, int8_t, int32_t, double, or std::string.
+     * Keys should be registered once at startup, since each call adds a new
+     * handle.
+     */
+    template <class T>
+    KeyHandle<T> RegisterKey(std::string_view ID);
+
+    /**
+     * Sets the value of a registered key.
+     *
+     * With a version 2 Driver Station, this stores the value in the key's slot
+     * without any string operations, and only keys whose values changed are
+     * serialized by SendToDS().
+     */
+    void Set(KeyHandle<StatusLight> handle, StatusLight data);
+    void Set(KeyHandle<bool> handle, bool data);
+    void Set(KeyHandle<int8_t> handle, int8_t data);
+    void Set(KeyHandle<int32_t> handle, int32_t data);
+    void Set(KeyHandle<std::string> handle, std::string_view data);
+    void Set(KeyHandle<double> handle, double data);
 
     /**
      * Sends data currently in class's internal packet to Driver Station.
      */
     void SendToDS();
 
+    /**
+     * Uses the GUISettings.txt text generated from a Schema::Layout instead of
+     * reading GUISettings.txt.
+     *
+     * Takes effect the next time a Driver Station connects, so it should be
+     * called before the robot starts sending data.
+     */
+    template <const auto& layout>
+    void SetLayout();
+
+    /**
+     * Sends a record of the layout passed to SetLayout() to Driver Station.
+     *
+     * Version 4 Driver Stations receive the record as is. Older ones receive
+     * its fields as if each were passed to AddData().
+     */
+    template <const auto& layout>
+    void SendToDS(const Schema::Record<layout>& record);
+
+    /**
+     * Enables or disables delta encoding for version 2 Driver Stations.
+     *
+     * In delta mode, SendToDS() only sends values which changed since they
+     * were last sent. A full keyframe is still sent periodically and whenever
+     * the Driver Station detects a lost packet. Delta mode is enabled by
+     * default.
+     */
+    void SetDeltaMode(bool enable);
+
+    /**
+     * Sets how often SendToDS() sends a full keyframe in delta mode.
+     */
+    void SetKeyframeInterval(std::chrono::milliseconds interval);
+
+    /**
+     * Makes the next SendToDS() send a full keyframe.
+     */
+    void RequestKeyframe();
+
+    struct BandwidthStats {
+        // Bytes of display data sent to the Driver Station
+        uint64_t bytesSent = 0;
+
+        // Bytes delta encoding avoided sending
+        uint64_t bytesSaved = 0;
+    };
+
+    /**
+     * Returns how much bandwidth display data used and how much delta encoding
+     * saved compared to sending every value each time.
+     */
+    BandwidthStats GetBandwidthStats() const;
+
     /**
      * Add an autonomous function.
      */
@@ -83,7 +188,13 @@ public:
 private:
     using steady_clock = std::chrono::steady_clock;
 
-    Packet m_packet;
+    // Reserved once for the largest datagram and reused for every send
+    Packet m_packet{UdpSocket::kMaxDatagramSize};
+
+    /* Reused by the receive thread for keepalives and guiCreate fragments so
+     * they don't allocate once it's grown
+     */
+    Packet m_replyPacket;
 
     UdpSocket m_socket;  // socket for sending data to Driver Station
     uint32_t m_dsIP;     // IP address of Driver Station
@@ -113,13 +224,208 @@ private:
     std::mutex m_ipMutex;
     std::atomic<bool> m_recvRunning{false};
 
+    // Protocol version negotiated with the Driver Station at connect
+    std::atomic<uint8_t> m_dsVersion{Protocol::kVersion1};
+
+    struct KeyTable {
+        std::vector<std::string> keys;
+
+        /* Views into keys, so keys passed to AddData() are looked up without
+         * constructing a std::string
+         */
+        std::unordered_map<std::string_view, uint16_t> ids;
+    };
+
+    // Key IDs sent to the Driver Station with the last guiCreate
+    std::shared_ptr<const KeyTable> m_keyIds = std::make_shared<KeyTable>();
+
+    // Encoding state captured when the current packet was started
+    bool m_packetStarted = false;
+    uint8_t m_packetVersion = Protocol::kVersion1;
+    std::shared_ptr<const KeyTable> m_packetKeys;
+
+    /* Latest value of a key, stored in its wire encoding without the length
+     * prefix strings have
+     */
+    struct Slot {
+        Protocol::ValueType type = Protocol::ValueType::Char;
+        std::string value;
+
+        // True once the value has been set
+        bool hasValue = false;
+
+        // True if the Driver Station hasn't received the current value
+        bool changed = false;
+    };
+
+    // Values for version 2 Driver Stations indexed by key ID
+    std::vector<Slot> m_slots;
+
+    // IDs of the slots whose changed flag is set, in the order they changed
+    std::vector<uint16_t> m_dirtySlots;
+
+    // Sum of EntrySize() over the slots that have a value
+    size_t m_slotsSize = 0;
+
+    // Marks a handle whose key isn't in the current key table
+    static constexpr uint16_t kNoKeyId = UINT16_MAX;
+
+    struct Handle {
+        std::string name;
+
+        // ID of the key in m_packetKeys
+        uint16_t id = kNoKeyId;
+    };
+
+    // Keys registered with RegisterKey() indexed by handle
+    std::vector<Handle> m_handles;
+
+    // Marks a key passed by name instead of by handle
+    static constexpr size_t kNoHandle = SIZE_MAX;
+
+    // Names a key by string or by handle
+    struct KeyRef {
+        std::string_view name;
+        size_t handle = kNoHandle;
+    };
+
+    uint32_t m_sequence = 0;
+
+    // Epoch of the send timestamps in display packets
+    steady_clock::time_point m_startTime = steady_clock::now();
+
+    bool m_deltaMode = true;
+    std::chrono::milliseconds m_keyframeInterval{1000};
+    steady_clock::time_point m_lastKeyframe;
+    std::atomic<bool> m_keyframeRequested{true};
+    BandwidthStats m_bandwidth;
+
+    // Layout from SetLayout(), used instead of GUISettings.txt if set
+    Schema::Description m_layout;
+    bool m_hasLayout = false;
+
+    // Last GUISettings transfer, kept to answer requests for lost fragments
+    std::vector<char> m_guiTransfer;
+    uint32_t m_guiTransferRawSize = 0;
+    uint16_t m_guiTransferId = 0;
+    uint8_t m_guiTransferFlags = 0;
+
+    // guiCreate payload and its hash, sent when a display's cache misses
+    Packet m_layoutPayload;
+    uint64_t m_layoutHash = 0;
+
+    /**
+     * Appends a message header in the given protocol version.
+     *
+     * The robot thread passes the version captured by StartPacket(). The
+     * receive thread, which is the only writer of m_dsVersion, passes that.
+     */
+    void AppendHeader(Packet& packet, uint8_t version, Protocol::Opcode opcode);
+
+    /**
+     * Captures the connection state used to encode the current packet.
+     */
+    void StartPacket();
+
+    /**
+     * Adds a new handle for the key and returns its index.
+     */
+    size_t AddHandle(std::string_view ID);
+
+    /**
+     * Looks up the handles' key IDs in the current key table.
+     */
+    void ResolveHandles();
+
+    /**
+     * Encodes a value and adds it with AddEntry(). AddData() and Set() both
+     * forward here.
+     */
+    void AddValue(const KeyRef& key, StatusLight data);
+    void AddValue(const KeyRef& key, bool data);
+    void AddValue(const KeyRef& key, int8_t data);
+    void AddValue(const KeyRef& key, int32_t data);
+    void AddValue(const KeyRef& key, std::string_view data);
+    void AddValue(const KeyRef& key, double data);
+
+    /**
+     * Adds a display entry whose value is already in wire encoding.
+     *
+     * Version 1 entries are appended to the packet immediately. Version 2
+     * entries update the key's slot and are appended by SendToDS().
+     */
+    void AddEntry(Protocol::ValueType type, const KeyRef& key,
+                  const char* value, size_t size);
+
+    /**
+     * Stores the layout for the receive thread to send at connect.
+     */
+    void SetLayout(const Schema::Description& layout);
+
+    /**
+     * Sends a record in a Record message, or as display entries to Driver
+     * Stations older than version 4.
+     */
+    void SendRecord(const Schema::Description& layout, const char* data);
+
+    /**
+     * Appends the message header, flags, sequence number, and send time which
+     * start Display and Record messages.
+     *
+     * The header uses the version captured by StartPacket(), which the rest of
+     * the message is encoded in.
+     */
+    void AppendSequenceHeader(Protocol::Opcode opcode, uint8_t flags,
+                              steady_clock::time_point time);
+
+    /**
+     * Appends a version 2 display message built from the key slots.
+     */
+    void AppendSlots();
+
+    /**
+     * Appends a slot's entry to the packet, which must already have room for
+     * it, and clears its changed flag.
+     */
+    void AppendSlot(uint16_t id);
+
+    /**
+     * Returns the number of bytes a slot's value takes in a display packet.
+     */
+    static size_t EntrySize(const Slot& slot);
+
+    /**
+     * Appends the record layout sent to version 4 Driver Stations after the
+     * key table.
+     */
+    static void AppendRecordLayout(Packet& packet, const KeyTable& keyIds,
+                                   const Schema::Description& layout);
+
     /**
      * Calls clear() on the packet automatically after sending it.
      */
     void SendToDS(Packet& packet);
 
+    /**
+     * Compresses the guiCreate payload if that makes it smaller and sends it
+     * as a new fragmented transfer.
+     */
+    void SendGuiTransfer(const Packet& payload);
+
+    /**
+     * Sends one fragment of the current GUISettings transfer.
+     */
+    void SendGuiFragment(uint16_t index);
+
+    /**
+     * Returns the number of fragments in the current GUISettings transfer.
+     */
+    uint16_t GuiFragmentCount() const;
+
     /**
      * Receives control commands from Driver Station and processes them.
      */
     void ReceiveFromDS();
 };
+
+#include "DSDisplay/DSDisplay.inl"
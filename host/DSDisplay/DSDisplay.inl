@@ -0,0 +1,26 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#pragma once
+
+#include <type_traits>
+
+template <class T>
+DSDisplay::KeyHandle<T> DSDisplay::RegisterKey(std::string_view ID) {
+    static_assert(std::is_same_v<T, StatusLight> || std::is_same_v<T, bool> ||
+                      std::is_same_v<T, int8_t> || std::is_same_v<T, int32_t> ||
+                      std::is_same_v<T, std::string> ||
+                      std::is_same_v<T, double>,
+                  "DSDisplay keys must hold a type AddData() accepts");
+
+    return KeyHandle<T>(AddHandle(ID));
+}
+
+template <const auto& layout>
+void DSDisplay::SetLayout() {
+    SetLayout(Schema::Describe<layout>());
+}
+
+template <const auto& layout>
+void DSDisplay::SendToDS(const Schema::Record<layout>& record) {
+    SendRecord(Schema::Describe<layout>(), record.Data());
+}
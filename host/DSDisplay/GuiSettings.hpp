@@ -0,0 +1,110 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#pragma once
+
+#include <stddef.h>
+
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * Tokenizer for the lines of GUISettings.txt
+ *
+ * The robot numbers the file's keys for version 2 packets and the display
+ * builds its elements from them, so both read key lists with these functions
+ * to agree on what a key is.
+ */
+namespace GuiSettings {
+
+/**
+ * Returns true if c separates tokens
+ *
+ * Carriage returns are whitespace so files with Windows line endings work.
+ */
+constexpr bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+/**
+ * Advances pos past any spaces in line
+ */
+inline void skipSpaces(std::string_view line, size_t& pos) {
+    while (pos < line.size() && isSpace(line[pos])) {
+        pos++;
+    }
+}
+
+/**
+ * Returns the characters from pos up to the next space or comma and advances
+ * pos past them
+ */
+inline std::string_view readToken(std::string_view line, size_t& pos) {
+    size_t start = pos;
+    while (pos < line.size() && !isSpace(line[pos]) && line[pos] != ',') {
+        pos++;
+    }
+
+    return line.substr(start, pos - start);
+}
+
+/**
+ * Reads a comma-separated key list starting at pos, calling func with each
+ * key in order
+ *
+ * Spaces before a key are skipped, so "A, B" is two keys.
+ *
+ * @return false if a key is empty, with pos where the key was expected
+ */
+template <class Func>
+bool readKeys(std::string_view line, size_t& pos, Func func) {
+    while (true) {
+        skipSpaces(line, pos);
+
+        auto key = readToken(line, pos);
+        if (key.empty()) {
+            return false;
+        }
+        func(key);
+
+        if (pos >= line.size() || line[pos] != ',') {
+            return true;
+        }
+        pos++;
+    }
+}
+
+/**
+ * Returns the keys used by the file in order of first appearance
+ *
+ * PAGE lines have no keys and are skipped.
+ */
+inline std::vector<std::string> parseKeys(std::string_view text) {
+    std::vector<std::string> keys;
+    std::unordered_set<std::string_view> seen;
+
+    size_t lineStart = 0;
+    while (lineStart < text.size()) {
+        size_t lineEnd = text.find('\n', lineStart);
+        if (lineEnd == std::string_view::npos) {
+            lineEnd = text.size();
+        }
+        auto line = text.substr(lineStart, lineEnd - lineStart);
+        lineStart = lineEnd + 1;
+
+        size_t pos = 0;
+        skipSpaces(line, pos);
+        if (readToken(line, pos) == "PAGE") {
+            continue;
+        }
+
+        readKeys(line, pos, [&](std::string_view key) {
+            if (seen.emplace(key).second) {
+                keys.emplace_back(key);
+            }
+        });
+    }
+
+    return keys;
+}
+
+}  // namespace GuiSettings
@@ -5,27 +5,66 @@
 #include <arpa/inet.h>
 #include <netinet/in.h>
 
+#include <algorithm>
+#include <cassert>
 #include <cstring>
 
+Packet::Packet(size_t capacity) : m_packetData(capacity) {}
+
 void Packet::append(const void* data, size_t sizeInBytes) {
     if (data && (sizeInBytes > 0)) {
-        size_t start = m_packetData.size();
-        m_packetData.resize(start + sizeInBytes);
-        std::memcpy(&m_packetData[start], data, sizeInBytes);
+        reserve(m_size + sizeInBytes);
+        appendUnchecked(data, sizeInBytes);
+    }
+}
+
+void Packet::appendUnchecked(const void* data, size_t sizeInBytes) {
+    assert(m_size + sizeInBytes <= m_packetData.size());
+
+    std::memcpy(m_packetData.data() + m_size, data, sizeInBytes);
+    m_size += sizeInBytes;
+}
+
+size_t Packet::appendPlaceholder(size_t sizeInBytes) {
+    reserve(m_size + sizeInBytes);
+
+    size_t offset = m_size;
+    m_size += sizeInBytes;
+    return offset;
+}
+
+void Packet::patch(size_t offset, uint16_t data) {
+    assert(offset + sizeof(data) <= m_size);
+
+    uint16_t toWrite = htons(data);
+    std::memcpy(&m_packetData[offset], &toWrite, sizeof(toWrite));
+}
+
+void Packet::patch(size_t offset, uint32_t data) {
+    assert(offset + sizeof(data) <= m_size);
+
+    uint32_t toWrite = htonl(data);
+    std::memcpy(&m_packetData[offset], &toWrite, sizeof(toWrite));
+}
+
+void Packet::reserve(size_t sizeInBytes) {
+    // Doubling keeps the number of reallocations logarithmic in the size
+    if (sizeInBytes > m_packetData.size()) {
+        m_packetData.resize(std::max(sizeInBytes, 2 * m_packetData.size()));
     }
 }
 
-void Packet::clear() { m_packetData.clear(); }
+void Packet::clear() { m_size = 0; }
 
 const void* Packet::getData() const {
-    if (!m_packetData.empty()) {
+    if (m_size > 0) {
         return &m_packetData[0];
     } else {
         return nullptr;
     }
 }
 
-size_t Packet::getDataSize() const { return m_packetData.size(); }
+size_t Packet::getDataSize() const { return m_size; }
 
 Packet& Packet::operator<<(bool data) {
     *this << static_cast<uint8_t>(data);
@@ -79,11 +118,12 @@ Packet& Packet::operator<<(double data) {
 Packet& Packet::operator<<(const std::string& data) {
     // First insert string length
     uint32_t length = static_cast<uint32_t>(data.size());
+    reserve(m_size + sizeof(length) + length);
     *this << length;
 
     // Then insert characters
     if (length > 0) {
-        append(data.c_str(), length * sizeof(std::string::value_type));
+        appendUnchecked(data.c_str(), length * sizeof(std::string::value_type));
     }
 
     return *this;
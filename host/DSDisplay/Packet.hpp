@@ -9,15 +9,42 @@
 
 /**
  * Utility class to build blocks of data to transfer over the network
+ *
+ * The packet's buffer is only ever grown. clear() keeps it, so a packet which
+ * is reused for every send stops allocating once it's large enough.
  */
 class Packet {
 public:
-    Packet() = default;
+    /**
+     * Constructs an empty packet with room for capacity bytes
+     */
+    explicit Packet(size_t capacity = 0);
 
     // Append data to the end of the packet
     void append(const void* data, size_t sizeInBytes);
 
-    // Empty the packet
+    /* Append data to the end of the packet without checking whether it fits
+     *
+     * reserve() must have made room for the data first. This lets a caller
+     * which knows the size of several fields check the capacity once.
+     */
+    void appendUnchecked(const void* data, size_t sizeInBytes);
+
+    /* Appends sizeInBytes bytes to be filled in later with patch(), such as a
+     * length which isn't known until the data after it is written
+     *
+     * Returns the offset of the bytes in the packet.
+     */
+    size_t appendPlaceholder(size_t sizeInBytes);
+
+    // Overwrite data at the given offset in network byte order
+    void patch(size_t offset, uint16_t data);
+    void patch(size_t offset, uint32_t data);
+
+    // Make room for the packet to hold at least sizeInBytes bytes in total
+    void reserve(size_t sizeInBytes);
+
+    // Empty the packet, keeping its capacity
     void clear();
 
     /* Get a pointer to the data contained in the packet
@@ -53,6 +80,9 @@ private:
     bool operator==(const Packet& right) const;
     bool operator!=(const Packet& right) const;
 
-    // Data stored in the packet
+    /* Buffer the packet is built in. Its size is the packet's capacity, and
+     * only the first m_size bytes are data.
+     */
     std::vector<char> m_packetData;
+    size_t m_size = 0;
 };
@@ -0,0 +1,433 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <cstring>
+#include <initializer_list>
+
+/**
+ * Wire format shared by the robot-side DSDisplay and the DriverStationDisplay
+ *
+ * Version 1 messages from the robot start with a length-prefixed header string
+ * such as "display\r\n", and commands from the display are raw strings such as
+ * "connect\r\n". Version 2 replaces both with a three byte frame: a magic byte,
+ * the protocol version, and a one byte opcode. A version 1 message can never
+ * start with the magic byte (its first byte is either the high byte of a short
+ * string length or a lowercase letter), so receivers can tell the two formats
+ * apart from the first byte alone.
+ *
+ * The version is negotiated by "connect\r\n". A display which understands
+ * version 2 appends the magic byte and its highest supported version to the
+ * command. Older robots only compare the first nine bytes, so they ignore the
+ * offer and keep answering in version 1. Newer robots answer in the highest
+ * version both sides support.
+ *
+ * This header is intentionally free of platform and Qt dependencies so both
+ * ends can include it.
+ */
+namespace Protocol {
+
+constexpr uint8_t kMagic = 0xD5;
+
+constexpr uint8_t kVersion1 = 1;
+constexpr uint8_t kVersion2 = 2;
+
+// Version 2 plus the layout cache
+constexpr uint8_t kVersion3 = 3;
+
+// Version 3 plus fixed layout records
+constexpr uint8_t kVersion4 = 4;
+
+// Highest version this build of the protocol understands
+constexpr uint8_t kMaxVersion = kVersion4;
+
+// Size of a version 2 frame header
+constexpr size_t kFrameSize = 3;
+
+// Large enough for any header or command produced by the encoders below
+constexpr size_t kMaxHeaderSize = 24;
+
+enum class Opcode : uint8_t {
+    Invalid = 0,
+
+    // Robot to display
+    KeepAlive,
+    Display,
+    GuiCreate,
+    AutonList,
+    AutonConfirmed,
+
+    // Display to robot
+    Connect,
+    AutonSelect,
+    Resync,
+    GuiResend,
+
+    // Version 3 (robot to display, then display to robot)
+    LayoutHash,
+    LayoutMiss,
+
+    // Version 4 (robot to display)
+    Record
+};
+
+/* Type tags which precede each value in a Display message. Doubles are big
+ * endian IEEE 754 values and are only sent to version 2 displays; version 1
+ * displays receive them formatted as strings instead.
+ */
+enum class ValueType : uint8_t {
+    Char = 'c',
+    Int32 = 'i',
+    String = 's',
+    Double = 'd'
+};
+
+/* A version 2 Display message starts with a flags byte, a uint32 sequence
+ * number which increments by one per message, and a uint32 send time in
+ * microseconds which wraps around roughly every 71 minutes. Each entry is then
+ * a type tag, a uint16 key ID, and the value.
+ */
+
+// Set if the message contains every value instead of only changed ones
+constexpr uint8_t kKeyframe = 0x01;
+
+/* In version 2, the GuiCreate payload (the file followed by the key table) is
+ * optionally compressed and split into fragments of at most kFragmentSize
+ * bytes. Each fragment is sent as its own GuiCreate message starting with a
+ * FragmentHeader. A display missing fragments after a timeout sends GuiResend
+ * with the transfer ID, a uint16 count, and up to kMaxResendIndices uint16
+ * fragment indices.
+ */
+
+// Fragment payload size chosen to stay under a typical Ethernet MTU
+constexpr size_t kFragmentSize = 1200;
+
+// Set if the transfer was compressed with Compression::compress()
+constexpr uint8_t kCompressed = 0x01;
+
+// Keeps GuiResend within the robot's 256 byte receive buffer
+constexpr size_t kMaxResendIndices = 120;
+
+/* In version 3, the robot answers Connect with a LayoutHash message holding
+ * the layoutHash() of the GuiCreate payload instead of the payload itself.
+ * Displays keep payloads they've received on disk, so they can usually build
+ * the GUI without a transfer. A display which doesn't have the payload sends
+ * LayoutMiss with the hash, and the robot then sends the GuiCreate transfer
+ * as in version 2.
+ */
+
+/* In version 4, the GuiCreate payload ends with the layout of the robot's
+ * record: a uint16 field count, then for each field a uint16 key ID, a type
+ * tag, a uint16 offset, and a uint16 size. The count is zero if the robot
+ * doesn't use a record. A Record message starts with the same flags, sequence
+ * number, and send time as a version 2 Display message, followed by the
+ * record. Each field holds its value in the same encoding as a Display entry,
+ * so the display decodes it at its offset without type tags or key IDs.
+ * String fields have room for a fixed number of bytes after the length.
+ */
+
+struct FragmentHeader {
+    uint16_t transferId = 0;
+    uint16_t index = 0;
+    uint16_t count = 0;
+    uint8_t flags = 0;
+
+    // Size of the transfer as sent, after compression
+    uint32_t transferSize = 0;
+
+    // Size of the transfer after decompression
+    uint32_t rawSize = 0;
+};
+
+constexpr size_t kFragmentHeaderSize = 15;
+
+struct Header {
+    /* Version the message was framed with. For Connect, this is the highest
+     * version offered by the display instead.
+     */
+    uint8_t version = kVersion1;
+
+    Opcode opcode = Opcode::Invalid;
+};
+
+/**
+ * Returns the version 1 header string for the given opcode, or nullptr if the
+ * opcode has no version 1 equivalent
+ */
+inline const char* v1Name(Opcode opcode) {
+    switch (opcode) {
+        case Opcode::KeepAlive:
+            return "\r\n";
+        case Opcode::Display:
+            return "display\r\n";
+        case Opcode::GuiCreate:
+            return "guiCreate\r\n";
+        case Opcode::AutonList:
+            return "autonList\r\n";
+        case Opcode::AutonConfirmed:
+            return "autonConfirmed\r\n";
+        case Opcode::Connect:
+            return "connect\r\n";
+        case Opcode::AutonSelect:
+            return "autonSelect\r\n";
+        default:
+            return nullptr;
+    }
+}
+
+/**
+ * Returns the opcode matching a version 1 header string, or Opcode::Invalid
+ */
+inline Opcode v1Opcode(const char* name, size_t length) {
+    for (uint8_t i = static_cast<uint8_t>(Opcode::KeepAlive);
+         i <= static_cast<uint8_t>(Opcode::AutonSelect); i++) {
+        auto opcode = static_cast<Opcode>(i);
+        const char* candidate = v1Name(opcode);
+        if (std::strlen(candidate) == length &&
+            std::memcmp(candidate, name, length) == 0) {
+            return opcode;
+        }
+    }
+
+    return Opcode::Invalid;
+}
+
+inline void writeU16(char* buf, uint16_t value) {
+    buf[0] = static_cast<char>(value >> 8);
+    buf[1] = static_cast<char>(value);
+}
+
+inline void writeU32(char* buf, uint32_t value) {
+    buf[0] = static_cast<char>(value >> 24);
+    buf[1] = static_cast<char>(value >> 16);
+    buf[2] = static_cast<char>(value >> 8);
+    buf[3] = static_cast<char>(value);
+}
+
+inline void writeU64(char* buf, uint64_t value) {
+    writeU32(buf, value >> 32);
+    writeU32(buf + 4, value);
+}
+
+inline void writeF64(char* buf, double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeU64(buf, bits);
+}
+
+inline uint16_t readU16(const char* buf) {
+    auto data = reinterpret_cast<const uint8_t*>(buf);
+    return static_cast<uint16_t>(data[0] << 8 | data[1]);
+}
+
+inline uint32_t readU32(const char* buf) {
+    auto data = reinterpret_cast<const uint8_t*>(buf);
+    return static_cast<uint32_t>(data[0]) << 24 |
+           static_cast<uint32_t>(data[1]) << 16 |
+           static_cast<uint32_t>(data[2]) << 8 | static_cast<uint32_t>(data[3]);
+}
+
+inline uint64_t readU64(const char* buf) {
+    return static_cast<uint64_t>(readU32(buf)) << 32 | readU32(buf + 4);
+}
+
+inline double readF64(const char* buf) {
+    uint64_t bits = readU64(buf);
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/**
+ * Writes the header of a robot-to-display message into buf
+ *
+ * buf must have room for at least kMaxHeaderSize bytes.
+ *
+ * @return Number of bytes written
+ */
+inline size_t encodeHeader(char* buf, uint8_t version, Opcode opcode) {
+    if (version >= kVersion2) {
+        buf[0] = static_cast<char>(kMagic);
+        buf[1] = static_cast<char>(version);
+        buf[2] = static_cast<char>(opcode);
+        return kFrameSize;
+    }
+
+    const char* name = v1Name(opcode);
+    uint32_t length = std::strlen(name);
+    writeU32(buf, length);
+    std::memcpy(buf + sizeof(length), name, length);
+    return sizeof(length) + length;
+}
+
+/**
+ * Reads the header of a robot-to-display message starting at pos
+ *
+ * On success, pos is advanced past the header.
+ *
+ * @return false if the data doesn't start with a recognized header
+ */
+inline bool decodeHeader(const char* data, size_t size, size_t& pos,
+                         Header& header) {
+    if (pos >= size) {
+        return false;
+    }
+
+    if (static_cast<uint8_t>(data[pos]) == kMagic) {
+        if (pos + kFrameSize > size) {
+            return false;
+        }
+
+        header.version = static_cast<uint8_t>(data[pos + 1]);
+        header.opcode = static_cast<Opcode>(data[pos + 2]);
+        pos += kFrameSize;
+        return header.version >= kVersion2;
+    }
+
+    if (pos + sizeof(uint32_t) > size) {
+        return false;
+    }
+
+    uint32_t length = readU32(data + pos);
+    if (length > size - pos - sizeof(uint32_t)) {
+        return false;
+    }
+
+    header.version = kVersion1;
+    header.opcode = v1Opcode(data + pos + sizeof(uint32_t), length);
+    pos += sizeof(uint32_t) + length;
+    return header.opcode != Opcode::Invalid;
+}
+
+/**
+ * Writes a display-to-robot command into buf
+ *
+ * Version 1 commands are raw strings. Connect is always written in version 1
+ * framing followed by the version offer so older robots still recognize it.
+ * buf must have room for at least kMaxHeaderSize bytes.
+ *
+ * @return Number of bytes written
+ */
+inline size_t encodeCommand(char* buf, uint8_t version, Opcode opcode) {
+    if (opcode != Opcode::Connect && version >= kVersion2) {
+        return encodeHeader(buf, version, opcode);
+    }
+
+    const char* name = v1Name(opcode);
+    size_t length = std::strlen(name);
+    std::memcpy(buf, name, length);
+
+    if (opcode == Opcode::Connect) {
+        buf[length++] = static_cast<char>(kMagic);
+        buf[length++] = static_cast<char>(kMaxVersion);
+    }
+
+    return length;
+}
+
+/**
+ * Reads a display-to-robot command starting at pos
+ *
+ * On success, pos is advanced past the command.
+ *
+ * @return false if the data doesn't start with a recognized command
+ */
+inline bool decodeCommand(const char* data, size_t size, size_t& pos,
+                          Header& header) {
+    if (pos >= size) {
+        return false;
+    }
+
+    if (static_cast<uint8_t>(data[pos]) == kMagic) {
+        return decodeHeader(data, size, pos, header);
+    }
+
+    for (auto opcode : {Opcode::Connect, Opcode::AutonSelect}) {
+        const char* name = v1Name(opcode);
+        size_t length = std::strlen(name);
+        if (size - pos >= length &&
+            std::memcmp(data + pos, name, length) == 0) {
+            pos += length;
+            header.version = kVersion1;
+            header.opcode = opcode;
+
+            // Displays which understand version 2 append a version offer
+            if (opcode == Opcode::Connect && pos + 2 <= size &&
+                static_cast<uint8_t>(data[pos]) == kMagic) {
+                header.version = static_cast<uint8_t>(data[pos + 1]);
+                pos += 2;
+            }
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Writes a fragment header into buf, which must have room for at least
+ * kFragmentHeaderSize bytes
+ */
+inline void encodeFragmentHeader(char* buf, const FragmentHeader& header) {
+    writeU16(buf, header.transferId);
+    writeU16(buf + 2, header.index);
+    writeU16(buf + 4, header.count);
+    buf[6] = static_cast<char>(header.flags);
+    writeU32(buf + 7, header.transferSize);
+    writeU32(buf + 11, header.rawSize);
+}
+
+/**
+ * Reads a fragment header starting at pos
+ *
+ * On success, pos is advanced past the header.
+ *
+ * @return false if the header is truncated or inconsistent
+ */
+inline bool decodeFragmentHeader(const char* data, size_t size, size_t& pos,
+                                 FragmentHeader& header) {
+    if (pos + kFragmentHeaderSize > size) {
+        return false;
+    }
+
+    const char* buf = data + pos;
+    header.transferId = readU16(buf);
+    header.index = readU16(buf + 2);
+    header.count = readU16(buf + 4);
+    header.flags = static_cast<uint8_t>(buf[6]);
+    header.transferSize = readU32(buf + 7);
+    header.rawSize = readU32(buf + 11);
+    pos += kFragmentHeaderSize;
+
+    size_t expectedCount =
+        (header.transferSize + kFragmentSize - 1) / kFragmentSize;
+    if (expectedCount == 0) {
+        expectedCount = 1;
+    }
+
+    return header.count == expectedCount && header.index < header.count;
+}
+
+/**
+ * Returns the 64-bit FNV-1a hash of a GuiCreate payload
+ */
+inline uint64_t layoutHash(const char* data, size_t size) {
+    uint64_t hash = 14695981039346656037u;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= 1099511628211u;
+    }
+    return hash;
+}
+
+/**
+ * Returns the version both ends support given the display's offer
+ */
+inline uint8_t negotiate(uint8_t offeredVersion) {
+    return offeredVersion < kMaxVersion ? offeredVersion : kMaxVersion;
+}
+
+}  // namespace Protocol
@@ -0,0 +1,500 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <array>
+#include <cstring>
+#include <initializer_list>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+#include "DSDisplay/Protocol.hpp"
+
+/**
+ * Compile-time description of the elements a robot shows on the display
+ *
+ * A layout is declared once as a constexpr object. Both the GUISettings.txt
+ * text and a packed record with one fixed-size field per key are derived from
+ * it at compile time, so the two can't fall out of sync:
+ *
+ *   static constexpr auto kLayout = Schema::MakeLayout(
+ *       Schema::Text<double>("GYRO_VAL", Schema::kLeft, "Gyro: 0\\u00b0",
+ *                            "Gyro: %s\\u00b0"),
+ *       Schema::StatusLight("ARMS_CLOSED", Schema::kRight, "Arms Closed",
+ *                           "Arms Closed"));
+ *   static constexpr auto kGyroVal = kLayout.Find<double>("GYRO_VAL");
+ *
+ *   dsDisplay.SetLayout<kLayout>();
+ *
+ *   Schema::Record<kLayout> record;
+ *   record.Set(kGyroVal, gyro.GetAngle());
+ *   dsDisplay.SendToDS(record);
+ *
+ * Fields hold their values in wire encoding, so a version 4 display receives
+ * the record with a single copy and decodes each field at its offset. Invalid
+ * layouts and lookups of missing keys fail to compile.
+ */
+namespace Schema {
+
+enum Column { kLeft, kRight };
+
+// Encodings of DSDisplay::active and DSDisplay::inactive
+constexpr char kActive = 0;
+constexpr char kInactive = 2;
+
+// Value type of a string field with room for N bytes
+template <size_t N>
+struct String {};
+
+/**
+ * Wire type and size of each value type a key can have
+ *
+ * ArgType is the type Record::Set() takes for values of the field.
+ */
+template <class T>
+struct ValueTraits;
+
+template <>
+struct ValueTraits<bool> {
+    using ArgType = bool;
+    static constexpr Protocol::ValueType kType = Protocol::ValueType::Char;
+    static constexpr size_t kSize = 1;
+
+    static void Encode(char* buf, bool value) {
+        buf[0] = value ? kActive : kInactive;
+    }
+};
+
+template <>
+struct ValueTraits<int8_t> {
+    using ArgType = int8_t;
+    static constexpr Protocol::ValueType kType = Protocol::ValueType::Char;
+    static constexpr size_t kSize = 1;
+
+    static void Encode(char* buf, int8_t value) { buf[0] = value; }
+};
+
+template <>
+struct ValueTraits<int32_t> {
+    using ArgType = int32_t;
+    static constexpr Protocol::ValueType kType = Protocol::ValueType::Int32;
+    static constexpr size_t kSize = sizeof(int32_t);
+
+    static void Encode(char* buf, int32_t value) {
+        Protocol::writeU32(buf, value);
+    }
+};
+
+template <>
+struct ValueTraits<double> {
+    using ArgType = double;
+    static constexpr Protocol::ValueType kType = Protocol::ValueType::Double;
+    static constexpr size_t kSize = sizeof(double);
+
+    static void Encode(char* buf, double value) {
+        Protocol::writeF64(buf, value);
+    }
+};
+
+template <size_t N>
+struct ValueTraits<String<N>> {
+    static_assert(N > 0, "String fields need room for at least one byte");
+
+    using ArgType = std::string_view;
+    static constexpr Protocol::ValueType kType = Protocol::ValueType::String;
+    static constexpr size_t kSize = sizeof(uint32_t) + N;
+
+    // Strings longer than the field are truncated
+    static void Encode(char* buf, std::string_view value) {
+        size_t size = value.size() < N ? value.size() : N;
+        Protocol::writeU32(buf, size);
+        std::memcpy(buf + sizeof(uint32_t), value.data(), size);
+    }
+};
+
+struct Key {
+    const char* name = "";
+    Protocol::ValueType type = Protocol::ValueType::Char;
+    uint16_t size = 0;
+
+    /* Value of a one-byte field before it's set. Zero is active, so status
+     * lights and bools start out inactive instead.
+     */
+    char initial = 0;
+};
+
+template <class T>
+constexpr Key MakeKey(const char* name) {
+    Key key{name, ValueTraits<T>::kType, ValueTraits<T>::kSize};
+    if constexpr (std::is_same_v<T, bool>) {
+        key.initial = kInactive;
+    }
+    return key;
+}
+
+// Most keys one element can have
+constexpr size_t kMaxKeys = 8;
+
+struct Element {
+    // Element name in GUISettings.txt, such as "TEXT" or "PAGE"
+    const char* name = "";
+
+    Key keys[kMaxKeys] = {};
+    size_t keyCount = 0;
+
+    Column column = kLeft;
+    const char* startText = "";
+    const char* updateText = "";
+};
+
+template <class T>
+constexpr Element Text(const char* key, Column column, const char* startText,
+                       const char* updateText) {
+    Element element;
+    element.name = "TEXT";
+    element.keys[0] = MakeKey<T>(key);
+    element.keyCount = 1;
+    element.column = column;
+    element.startText = startText;
+    element.updateText = updateText;
+    return element;
+}
+
+constexpr Element StatusLight(const char* key, Column column,
+                              const char* startText, const char* updateText) {
+    Element element = Text<int8_t>(key, column, startText, updateText);
+    element.name = "STATUSLIGHT";
+    element.keys[0].initial = kInactive;
+    return element;
+}
+
+template <class T, class Fill = int32_t>
+constexpr Element ProgressBar(const char* valueKey, const char* fillKey,
+                              Column column, const char* startText,
+                              const char* updateText) {
+    Element element = Text<T>(valueKey, column, startText, updateText);
+    element.name = "PBAR";
+    element.keys[1] = MakeKey<Fill>(fillKey);
+    element.keyCount = 2;
+    return element;
+}
+
+template <class T>
+constexpr Element Graph(std::initializer_list<const char*> keys, Column column,
+                        const char* title, const char* period) {
+    if (keys.size() == 0 || keys.size() > kMaxKeys) {
+        throw std::length_error("Graphs must have 1 to kMaxKeys keys");
+    }
+
+    Element element;
+    element.name = "GRAPH";
+    for (auto key : keys) {
+        element.keys[element.keyCount++] = MakeKey<T>(key);
+    }
+    element.column = column;
+    element.startText = title;
+    element.updateText = period;
+    return element;
+}
+
+constexpr Element Page(const char* name) {
+    Element element;
+    element.name = "PAGE";
+    element.startText = name;
+    return element;
+}
+
+// Location of a key's value in a record
+struct FieldDesc {
+    const char* key = "";
+    Protocol::ValueType type = Protocol::ValueType::Char;
+    uint16_t offset = 0;
+    uint16_t size = 0;
+};
+
+// Typed handle for a field, returned by Layout::Find()
+template <class T>
+struct Field {
+    uint16_t offset = 0;
+};
+
+template <size_t N>
+class Layout {
+public:
+    constexpr explicit Layout(const std::array<Element, N>& elements)
+        : m_elements(elements) {
+        Validate();
+    }
+
+    /**
+     * Returns the number of distinct keys, which is also the number of fields
+     * in a record
+     */
+    constexpr size_t FieldCount() const {
+        size_t count = 0;
+        ForEachField([&](const Key&, size_t) { count++; });
+        return count;
+    }
+
+    /**
+     * Returns the field at the given index
+     *
+     * Fields are ordered by the first appearance of their key, which is the
+     * order DSDisplay assigns key IDs in.
+     */
+    constexpr FieldDesc GetField(size_t index) const {
+        FieldDesc desc;
+        size_t i = 0;
+        ForEachField([&](const Key& key, size_t offset) {
+            if (i++ == index) {
+                desc = FieldDesc{key.name, key.type,
+                                 static_cast<uint16_t>(offset), key.size};
+            }
+        });
+        return desc;
+    }
+
+    // Returns the size of a record in bytes
+    constexpr size_t RecordSize() const {
+        size_t size = 0;
+        ForEachField(
+            [&](const Key& key, size_t offset) { size = offset + key.size; });
+        return size;
+    }
+
+    /**
+     * Returns the field for a key, which must have been declared with type T
+     */
+    template <class T>
+    constexpr Field<T> Find(std::string_view name) const {
+        for (size_t i = 0; i < FieldCount(); i++) {
+            FieldDesc desc = GetField(i);
+            if (desc.key == name) {
+                if (desc.type != ValueTraits<T>::kType ||
+                    desc.size != ValueTraits<T>::kSize) {
+                    throw std::logic_error("Key has a different type");
+                }
+                return Field<T>{desc.offset};
+            }
+        }
+
+        throw std::logic_error("Key isn't in the layout");
+    }
+
+    /**
+     * Writes the initial value of each one-byte field into buf, which must
+     * start out zeroed
+     */
+    constexpr void WriteInitialRecord(char* buf) const {
+        ForEachField([&](const Key& key, size_t offset) {
+            if (key.type == Protocol::ValueType::Char) {
+                buf[offset] = key.initial;
+            }
+        });
+    }
+
+    // Returns the length of the GUISettings.txt text
+    constexpr size_t GuiSettingsSize() const {
+        size_t size = 0;
+        WriteGuiSettings([&](std::string_view text) { size += text.size(); });
+        return size;
+    }
+
+    // Writes the GUISettings.txt text into buf
+    constexpr void WriteGuiSettings(char* buf) const {
+        size_t pos = 0;
+        WriteGuiSettings([&](std::string_view text) {
+            for (auto c : text) {
+                buf[pos++] = c;
+            }
+        });
+    }
+
+private:
+    std::array<Element, N> m_elements;
+
+    /* Calls func with each distinct key and its offset in the record, in
+     * order of first appearance
+     */
+    template <class Func>
+    constexpr void ForEachField(Func&& func) const {
+        size_t offset = 0;
+        for (size_t i = 0; i < N; i++) {
+            for (size_t j = 0; j < m_elements[i].keyCount; j++) {
+                const Key& key = m_elements[i].keys[j];
+                if (!IsFirstUse(i, j)) {
+                    continue;
+                }
+
+                func(key, offset);
+                offset += key.size;
+            }
+        }
+    }
+
+    // Returns true if no key before the given one has the same name
+    constexpr bool IsFirstUse(size_t element, size_t index) const {
+        std::string_view name = m_elements[element].keys[index].name;
+        for (size_t i = 0; i <= element; i++) {
+            size_t end = i == element ? index : m_elements[i].keyCount;
+            for (size_t j = 0; j < end; j++) {
+                if (m_elements[i].keys[j].name == name) {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    // Passes each piece of the GUISettings.txt text to write in order
+    template <class Write>
+    constexpr void WriteGuiSettings(Write&& write) const {
+        for (const auto& element : m_elements) {
+            write(element.name);
+            write(" ");
+
+            if (element.keyCount > 0) {
+                for (size_t j = 0; j < element.keyCount; j++) {
+                    if (j > 0) {
+                        write(",");
+                    }
+                    write(element.keys[j].name);
+                }
+                write(element.column == kLeft ? " left \"" : " right \"");
+                write(element.startText);
+                write("\" \"");
+                write(element.updateText);
+                write("\"\n");
+            } else {
+                write("\"");
+                write(element.startText);
+                write("\"\n");
+            }
+        }
+    }
+
+    /* Throws for layouts GUISettings.txt can't represent, which fails the
+     * constexpr initialization of the layout
+     */
+    constexpr void Validate() const {
+        size_t offset = 0;
+        for (size_t i = 0; i < N; i++) {
+            const auto& element = m_elements[i];
+            for (size_t j = 0; j < element.keyCount; j++) {
+                std::string_view name = element.keys[j].name;
+                if (name.empty() ||
+                    name.find_first_of(" ,\"\r\n") != std::string_view::npos) {
+                    throw std::invalid_argument("Invalid key name");
+                }
+
+                if (IsFirstUse(i, j)) {
+                    offset += element.keys[j].size;
+                    continue;
+                }
+
+                // Every use of a key must agree on its type
+                for (size_t k = 0; k < FieldCount(); k++) {
+                    FieldDesc desc = GetField(k);
+                    if (desc.key == name &&
+                        (desc.type != element.keys[j].type ||
+                         desc.size != element.keys[j].size)) {
+                        throw std::invalid_argument(
+                            "Key used with different types");
+                    }
+                }
+            }
+
+            for (std::string_view text :
+                 {element.startText, element.updateText}) {
+                if (text.find_first_of("\"\r\n") != std::string_view::npos) {
+                    throw std::invalid_argument("Invalid element text");
+                }
+            }
+        }
+
+        // Offsets are sent as uint16
+        if (offset > UINT16_MAX) {
+            throw std::length_error("Record is too large");
+        }
+    }
+};
+
+template <class... Elements>
+constexpr Layout<sizeof...(Elements)> MakeLayout(const Elements&... elements) {
+    return Layout<sizeof...(Elements)>(
+        std::array<Element, sizeof...(Elements)>{elements...});
+}
+
+// GUISettings.txt text generated from a layout
+template <const auto& layout>
+inline constexpr auto kGuiSettings = [] {
+    std::array<char, layout.GuiSettingsSize()> text{};
+    layout.WriteGuiSettings(text.data());
+    return text;
+}();
+
+// Fields of a layout's record in key ID order
+template <const auto& layout>
+inline constexpr auto kFields = [] {
+    std::array<FieldDesc, layout.FieldCount()> fields{};
+    for (size_t i = 0; i < fields.size(); i++) {
+        fields[i] = layout.GetField(i);
+    }
+    return fields;
+}();
+
+// Record of a layout with every field at its initial value
+template <const auto& layout>
+inline constexpr auto kInitialRecord = [] {
+    std::array<char, layout.RecordSize()> data{};
+    layout.WriteInitialRecord(data.data());
+    return data;
+}();
+
+/**
+ * Type-erased view of a layout's generated data, which DSDisplay keeps
+ */
+struct Description {
+    std::string_view guiSettings;
+    const FieldDesc* fields = nullptr;
+    size_t fieldCount = 0;
+    size_t recordSize = 0;
+};
+
+template <const auto& layout>
+constexpr Description Describe() {
+    return Description{
+        std::string_view(kGuiSettings<layout>.data(),
+                         kGuiSettings<layout>.size()),
+        kFields<layout>.data(), kFields<layout>.size(), layout.RecordSize()};
+}
+
+/**
+ * Holds a value for every key of a layout at fixed offsets
+ *
+ * Status lights and bools start out inactive. Other fields start out as zero
+ * or empty strings.
+ */
+template <const auto& layout>
+class Record {
+public:
+    Record() : m_data(kInitialRecord<layout>) {}
+
+    template <class T>
+    void Set(Field<T> field, typename ValueTraits<T>::ArgType value) {
+        ValueTraits<T>::Encode(m_data.data() + field.offset, value);
+    }
+
+    const char* Data() const { return m_data.data(); }
+
+    static constexpr size_t Size() { return layout.RecordSize(); }
+
+private:
+    std::array<char, layout.RecordSize()> m_data;
+};
+
+}  // namespace Schema
@@ -0,0 +1,99 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#include "FragmentAssembler.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "DSDisplay/Compression.hpp"
+
+bool FragmentAssembler::add(const Protocol::FragmentHeader& header,
+                            const char* data, size_t size) {
+    if (header.rawSize > kMaxTransferSize ||
+        header.transferSize > kMaxTransferSize) {
+        return false;
+    }
+
+    // Late duplicates of a finished transfer mustn't start it over
+    if (!m_active && m_hasCompleted &&
+        header.transferId == m_completedId) {
+        return false;
+    }
+
+    if (!m_active || header.transferId != m_header.transferId) {
+        m_header = header;
+        m_data.assign(header.transferSize, 0);
+        m_received.assign(header.count, false);
+        m_receivedCount = 0;
+        m_active = true;
+    }
+
+    // Fragments of one transfer must agree on its shape
+    if (header.count != m_header.count ||
+        header.transferSize != m_header.transferSize ||
+        header.rawSize != m_header.rawSize || header.flags != m_header.flags) {
+        return false;
+    }
+
+    size_t start = header.index * Protocol::kFragmentSize;
+    size_t length = std::min(Protocol::kFragmentSize, m_data.size() - start);
+    if (size != length || m_received[header.index]) {
+        return false;
+    }
+
+    if (length > 0) {
+        std::memcpy(m_data.data() + start, data, length);
+    }
+    m_received[header.index] = true;
+    m_receivedCount++;
+
+    return m_receivedCount == m_received.size();
+}
+
+std::vector<uint16_t> FragmentAssembler::missing(size_t maxCount) const {
+    std::vector<uint16_t> indices;
+
+    for (size_t i = 0; i < m_received.size() && indices.size() < maxCount;
+         i++) {
+        if (!m_received[i]) {
+            indices.push_back(i);
+        }
+    }
+
+    return indices;
+}
+
+bool FragmentAssembler::take(std::vector<char>& body) {
+    if (!m_active || m_receivedCount != m_received.size()) {
+        return false;
+    }
+
+    m_completedId = m_header.transferId;
+    m_hasCompleted = true;
+
+    bool ok = true;
+    if (m_header.flags & Protocol::kCompressed) {
+        body.resize(m_header.rawSize);
+        ok = Compression::decompress(m_data.data(), m_data.size(), body.data(),
+                                     body.size());
+    } else {
+        body = std::move(m_data);
+    }
+
+    reset();
+    return ok;
+}
+
+bool FragmentAssembler::isActive() const { return m_active; }
+
+uint16_t FragmentAssembler::transferId() const { return m_header.transferId; }
+
+void FragmentAssembler::reset() {
+    m_data.clear();
+    m_received.clear();
+    m_receivedCount = 0;
+    m_active = false;
+}
+
+void FragmentAssembler::forgetCompleted() { m_hasCompleted = false; }
@@ -0,0 +1,64 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "DSDisplay/Protocol.hpp"
+
+/**
+ * Reassembles a fragmented transfer such as a version 2 guiCreate
+ *
+ * Fragments may arrive in any order and more than once. A fragment from a
+ * different transfer than the one in progress discards it and starts over.
+ */
+class FragmentAssembler {
+public:
+    // Upper bound on the uncompressed size of a transfer
+    static constexpr uint32_t kMaxTransferSize = 16 * 1024 * 1024;
+
+    /**
+     * Adds a fragment to the transfer
+     *
+     * @return true if this fragment completed the transfer
+     */
+    bool add(const Protocol::FragmentHeader& header, const char* data,
+             size_t size);
+
+    /**
+     * Returns up to maxCount indices of fragments which haven't arrived yet
+     */
+    std::vector<uint16_t> missing(size_t maxCount) const;
+
+    /**
+     * Moves the completed transfer into body, decompressing it if necessary
+     *
+     * @return false if no transfer is complete or it failed to decompress
+     */
+    bool take(std::vector<char>& body);
+
+    // Returns true if a transfer is partially received
+    bool isActive() const;
+
+    // Returns ID of the transfer in progress
+    uint16_t transferId() const;
+
+    // Discards any transfer in progress
+    void reset();
+
+    // Forgets the last completed transfer so it may be received again
+    void forgetCompleted();
+
+private:
+    Protocol::FragmentHeader m_header;
+    std::vector<char> m_data;
+    std::vector<bool> m_received;
+    size_t m_receivedCount = 0;
+    bool m_active = false;
+
+    // ID of the last transfer handed out by take()
+    uint16_t m_completedId = 0;
+    bool m_hasCompleted = false;
+};
@@ -0,0 +1,209 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#include "LayoutParser.hpp"
+
+#include <utility>
+
+#include "DSDisplay/GuiSettings.hpp"
+#include "Util.hpp"
+
+namespace {
+int hexDigit(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    } else if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    } else if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    } else {
+        return -1;
+    }
+}
+}  // namespace
+
+bool LayoutParser::parse(std::string_view text) {
+    m_elements.clear();
+    m_pages.clear();
+    m_errors.clear();
+
+    size_t lineStart = 0;
+    m_lineNumber = 1;
+    while (lineStart <= text.size()) {
+        size_t lineEnd = text.find('\n', lineStart);
+        if (lineEnd == std::string_view::npos) {
+            lineEnd = text.size();
+        }
+
+        m_line = text.substr(lineStart, lineEnd - lineStart);
+        m_pos = 0;
+
+        // Blank lines separate groups of elements
+        skipSpaces();
+        if (m_pos < m_line.size()) {
+            parseLine();
+        }
+
+        lineStart = lineEnd + 1;
+        m_lineNumber++;
+    }
+
+    return m_errors.empty();
+}
+
+const std::vector<ElementDesc>& LayoutParser::getElements() const {
+    return m_elements;
+}
+
+const std::vector<std::wstring>& LayoutParser::getPages() const {
+    return m_pages;
+}
+
+const std::vector<LayoutParser::Error>& LayoutParser::getErrors() const {
+    return m_errors;
+}
+
+void LayoutParser::parseLine() {
+    size_t typePos = m_pos;
+    auto type = readToken();
+    if (type == "PAGE") {
+        skipSpaces();
+
+        std::wstring name;
+        if (readQuoted(name)) {
+            m_pages.emplace_back(std::move(name));
+        }
+        return;
+    }
+
+    ElementDesc desc;
+    if (type == "TEXT") {
+        desc.type = ElementDesc::Type::Text;
+    } else if (type == "STATUSLIGHT") {
+        desc.type = ElementDesc::Type::StatusLight;
+    } else if (type == "PBAR") {
+        desc.type = ElementDesc::Type::ProgressBar;
+    } else if (type == "GRAPH") {
+        desc.type = ElementDesc::Type::Graph;
+    } else {
+        addError(typePos, "unknown element type '" + std::string(type) + "'");
+        return;
+    }
+
+    if (parseElement(desc)) {
+        if (m_pages.empty()) {
+            m_pages.emplace_back();
+        }
+        desc.page = m_pages.size() - 1;
+
+        m_elements.emplace_back(std::move(desc));
+    }
+}
+
+bool LayoutParser::parseElement(ElementDesc& desc) {
+    // The robot numbers keys with the same tokenizer, so both agree on them
+    auto addKey = [&](std::string_view key) { desc.keys.emplace_back(key); };
+    if (!GuiSettings::readKeys(m_line, m_pos, addKey)) {
+        addError(m_pos, "expected an ID string");
+        return false;
+    }
+
+    skipSpaces();
+    size_t columnPos = m_pos;
+    auto column = readToken();
+    if (column == "left") {
+        desc.column = ElementDesc::Column::Left;
+    } else if (column == "right") {
+        desc.column = ElementDesc::Column::Right;
+    } else {
+        addError(columnPos, "expected 'left' or 'right'");
+        return false;
+    }
+
+    skipSpaces();
+    if (!readQuoted(desc.startText)) {
+        return false;
+    }
+
+    skipSpaces();
+    size_t updatePos = m_pos;
+    if (!readQuoted(desc.updateText)) {
+        return false;
+    }
+
+    // Only the text between the quotes is checked
+    checkFormatSpecs(updatePos + 1, m_pos - 1);
+    return true;
+}
+
+void LayoutParser::skipSpaces() { GuiSettings::skipSpaces(m_line, m_pos); }
+
+std::string_view LayoutParser::readToken() {
+    return GuiSettings::readToken(m_line, m_pos);
+}
+
+bool LayoutParser::readQuoted(std::wstring& dest) {
+    if (m_pos >= m_line.size() || m_line[m_pos] != '"') {
+        addError(m_pos, "expected a quoted string");
+        return false;
+    }
+    size_t quotePos = m_pos++;
+
+    // Text between escapes is decoded a run at a time
+    size_t runStart = m_pos;
+    while (m_pos < m_line.size() && m_line[m_pos] != '"') {
+        if (m_line[m_pos] != '\\' || m_pos + 1 >= m_line.size() ||
+            m_line[m_pos + 1] != 'u') {
+            m_pos++;
+            continue;
+        }
+
+        uint32_t codeUnit = 0;
+        for (size_t i = m_pos + 2; i < m_pos + 6; i++) {
+            int digit = i < m_line.size() ? hexDigit(m_line[i]) : -1;
+            if (digit < 0) {
+                addError(m_pos, "\\u must be followed by four hex digits");
+                return false;
+            }
+            codeUnit = codeUnit << 4 | digit;
+        }
+
+        appendUtf8(dest, m_line.substr(runStart, m_pos - runStart));
+        dest += static_cast<wchar_t>(codeUnit);
+        m_pos += 6;
+        runStart = m_pos;
+    }
+
+    if (m_pos >= m_line.size()) {
+        addError(quotePos, "missing closing quote");
+        return false;
+    }
+
+    appendUtf8(dest, m_line.substr(runStart, m_pos - runStart));
+    m_pos++;
+    return true;
+}
+
+void LayoutParser::checkFormatSpecs(size_t start, size_t end) {
+    auto text = m_line.substr(0, end);
+
+    size_t pos = start;
+    while ((pos = text.find('%', pos)) != std::string_view::npos) {
+        FormatSpec spec;
+        if (pos + 1 < text.size() && text[pos + 1] == '%') {
+            pos += 2;
+        } else if (scanFormatSpec(text, pos, spec)) {
+            if (!spec.supported) {
+                addError(pos, "width and precision may have at most " +
+                                  std::to_string(kMaxFormatDigits) +
+                                  " digits");
+            }
+            pos = spec.end;
+        } else {
+            pos++;
+        }
+    }
+}
+
+void LayoutParser::addError(size_t pos, std::string message) {
+    m_errors.push_back({m_lineNumber, pos + 1, std::move(message)});
+}
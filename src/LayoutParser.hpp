@@ -0,0 +1,112 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Element declared by a line of GUISettings.txt
+ */
+struct ElementDesc {
+    enum class Type : uint8_t { Text, StatusLight, ProgressBar, Graph };
+    enum class Column : uint8_t { Left, Right };
+
+    Type type = Type::Text;
+    Column column = Column::Left;
+    std::vector<std::string> keys;
+    std::wstring startText;
+    std::wstring updateText;
+
+    // Index of the page in LayoutParser::getPages() the element is on
+    size_t page = 0;
+};
+
+/**
+ * Parses GUISettings.txt in a single pass over the text
+ *
+ * Each nonblank line has the form
+ *
+ *     TYPE KEY1,KEY2,... COLUMN "Start text" "Update text"
+ *
+ * or
+ *
+ *     PAGE "Name"
+ *
+ * which puts the elements after it on a new page. Elements before the first
+ * PAGE line are on an unnamed page.
+ *
+ * Quoted text is UTF-8 and may contain \uXXXX escapes. Malformed lines are
+ * skipped and reported with their line and column, so one typo doesn't hide
+ * the rest of the layout. Format specs in update text which the display can't
+ * apply are reported too, but their element is kept and shows them as is.
+ */
+class LayoutParser {
+public:
+    struct Error {
+        // One-based position of the problem
+        size_t line = 0;
+        size_t column = 0;
+
+        std::string message;
+    };
+
+    /**
+     * Parses the text, replacing the results of any previous call
+     *
+     * @return false if any line was malformed
+     */
+    bool parse(std::string_view text);
+
+    /**
+     * Returns the elements declared by well-formed lines in order
+     */
+    const std::vector<ElementDesc>& getElements() const;
+
+    /**
+     * Returns the names of the pages in order
+     */
+    const std::vector<std::wstring>& getPages() const;
+
+    /**
+     * Returns a description of each malformed line
+     */
+    const std::vector<Error>& getErrors() const;
+
+private:
+    std::vector<ElementDesc> m_elements;
+    std::vector<std::wstring> m_pages;
+    std::vector<Error> m_errors;
+
+    // Line being parsed and the position in it
+    std::string_view m_line;
+    size_t m_lineNumber = 0;
+    size_t m_pos = 0;
+
+    // Adds the element or page declared by the line
+    void parseLine();
+
+    /* Parses the rest of an element's line after its type. Returns false and
+     * records an error if the line is malformed.
+     */
+    bool parseElement(ElementDesc& desc);
+
+    void skipSpaces();
+
+    // Returns the characters up to the next space or comma
+    std::string_view readToken();
+
+    // Reads a quoted string, decoding UTF-8 and \uXXXX escapes into dest
+    bool readQuoted(std::wstring& dest);
+
+    /* Records an error for each format spec between the given positions of
+     * the current line which is too wide for the display to apply
+     */
+    void checkFormatSpecs(size_t start, size_t end);
+
+    // Records an error at the given position in the current line
+    void addError(size_t pos, std::string message);
+};
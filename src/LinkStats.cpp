@@ -0,0 +1,151 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#include "LinkStats.hpp"
+
+#include <cmath>
+#include <fstream>
+
+bool LinkStats::addPacket(uint32_t sequence, uint32_t sendTime, size_t bytes,
+                          steady_clock::time_point arrival) {
+    int64_t arrivalTime =
+        std::chrono::duration_cast<std::chrono::microseconds>(arrival -
+                                                              m_startTime)
+            .count();
+
+    m_current.bytes += bytes;
+
+    if (m_haveSequence) {
+        // Differences are taken modulo 2^32 so wraparound is handled
+        auto delta = static_cast<int32_t>(sequence - m_highestSequence);
+
+        // A sequence far in the past means the robot restarted its count
+        if (delta <= -kMaxReorder) {
+            resetSequence();
+            return addPacket(sequence, sendTime, 0, arrival);
+        }
+
+        if (delta <= 0) {
+            auto age = static_cast<uint32_t>(-delta);
+
+            // Duplicates are neither lost nor reordered
+            if (age < 64 && (m_received & (uint64_t{1} << age))) {
+                return false;
+            }
+
+            // Packets which fell out of the window stay counted as lost
+            if (age >= 64) {
+                return false;
+            }
+
+            /* A packet older than the newest one was counted as lost when the
+             * gap was seen, possibly in an earlier interval, so count it as
+             * reordered instead
+             */
+            m_current.reordered++;
+            m_received |= uint64_t{1} << age;
+            uint32_t elapsed = m_current.time - m_lostTime[sequence % 64];
+            if (elapsed == 0) {
+                if (m_current.lost > 0) {
+                    m_current.lost--;
+                }
+            } else if (elapsed <= m_history.size()) {
+                auto& interval = m_history[m_history.size() - elapsed];
+                if (interval.lost > 0) {
+                    interval.lost--;
+                }
+            }
+            return false;
+        }
+
+        m_current.lost += delta - 1;
+        m_received = delta < 64 ? m_received << delta : 0;
+
+        // Remember which interval counted each gap still in the window
+        for (uint32_t age = 1; age < 64 && age < static_cast<uint32_t>(delta);
+             age++) {
+            m_lostTime[(sequence - age) % 64] = m_current.time;
+        }
+
+        // Only in-order packets contribute to jitter
+        auto transit = (arrivalTime - m_lastArrival) -
+                       static_cast<int32_t>(sendTime - m_lastSendTime);
+        m_jitter += (std::abs(static_cast<double>(transit)) - m_jitter) / 16.0;
+    }
+
+    m_haveSequence = true;
+    m_highestSequence = sequence;
+    m_received |= 1;
+    m_lastArrival = arrivalTime;
+    m_lastSendTime = sendTime;
+    m_current.received++;
+
+    return true;
+}
+
+void LinkStats::addBytesSaved(size_t bytes) { m_current.bytesSaved += bytes; }
+
+void LinkStats::tick() {
+    m_current.jitter = m_jitter / 1000.0;
+    m_history.push_back(m_current);
+    if (m_history.size() > kHistorySize) {
+        m_history.pop_front();
+    }
+
+    uint32_t time = m_current.time;
+    m_current = Interval{};
+    m_current.time = time + 1;
+}
+
+void LinkStats::resetSequence() {
+    m_haveSequence = false;
+    m_received = 0;
+    m_jitter = 0.0;
+}
+
+LinkStats::Summary LinkStats::summary() const {
+    Summary summary;
+
+    uint64_t received = 0;
+    uint64_t lost = 0;
+    uint64_t bytes = 0;
+    uint64_t bytesSaved = 0;
+
+    size_t count =
+        m_history.size() < kWindowSize ? m_history.size() : kWindowSize;
+    for (auto it = m_history.end() - count; it != m_history.end(); ++it) {
+        // Reordered packets arrived too, just late
+        received += it->received + it->reordered;
+        lost += it->lost;
+        summary.reordered += it->reordered;
+        bytes += it->bytes;
+        bytesSaved += it->bytesSaved;
+    }
+
+    if (received + lost > 0) {
+        summary.lossPercent = 100.0 * lost / (received + lost);
+    }
+    if (count > 0) {
+        summary.bytesPerSecond = static_cast<double>(bytes) / count;
+        summary.savedPerSecond = static_cast<double>(bytesSaved) / count;
+    }
+    summary.jitter = m_jitter / 1000.0;
+
+    return summary;
+}
+
+bool LinkStats::exportCsv(const std::string& fileName) const {
+    std::ofstream file(fileName, std::ofstream::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    file << "time,received,lost,reordered,bytes,bytesSaved,jitterMs\n";
+    for (const auto& interval : m_history) {
+        file << interval.time << ',' << interval.received << ','
+             << interval.lost << ',' << interval.reordered << ','
+             << interval.bytes << ',' << interval.bytesSaved << ','
+             << interval.jitter << '\n';
+    }
+
+    return static_cast<bool>(file);
+}
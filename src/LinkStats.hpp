@@ -0,0 +1,125 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <array>
+#include <chrono>
+#include <deque>
+#include <string>
+
+/**
+ * Tracks the quality of the robot's telemetry link
+ *
+ * Statistics are accumulated into one second intervals. Summaries cover a
+ * rolling window of recent intervals, and the full history of the session can
+ * be exported as CSV.
+ */
+class LinkStats {
+public:
+    struct Interval {
+        // Seconds since the session started
+        uint32_t time = 0;
+
+        /* Packets applied in order. Late ones are counted in reordered and
+         * removed from the lost count of the interval which saw their gap,
+         * unless they arrive 64 or more packets late.
+         */
+        uint32_t received = 0;
+        uint32_t lost = 0;
+        uint32_t reordered = 0;
+        uint64_t bytes = 0;
+        uint64_t bytesSaved = 0;
+
+        // Interarrival jitter at the end of the interval in milliseconds
+        double jitter = 0.0;
+    };
+
+    struct Summary {
+        double lossPercent = 0.0;
+        uint32_t reordered = 0;
+        double jitter = 0.0;
+        double bytesPerSecond = 0.0;
+        double savedPerSecond = 0.0;
+    };
+
+    // Number of intervals covered by summary()
+    static constexpr size_t kWindowSize = 10;
+
+    // Number of intervals kept for export (one hour)
+    static constexpr size_t kHistorySize = 3600;
+
+    /* Packets further than this behind the newest one are assumed to come
+     * from a restarted robot rather than being reordered
+     */
+    static constexpr int32_t kMaxReorder = 1000;
+
+    /**
+     * Records the arrival of a sequenced packet
+     *
+     * @param sequence Sequence number of the packet
+     * @param sendTime Robot's send timestamp in microseconds
+     * @param bytes    Size of the packet
+     * @param arrival  Time the packet arrived
+     * @return false if the packet is older than one already received and
+     *         should be dropped
+     */
+    bool addPacket(uint32_t sequence, uint32_t sendTime, size_t bytes,
+                   std::chrono::steady_clock::time_point arrival =
+                       std::chrono::steady_clock::now());
+
+    /**
+     * Records bytes delta encoding avoided sending
+     */
+    void addBytesSaved(size_t bytes);
+
+    /**
+     * Closes the current interval. Call once per second.
+     */
+    void tick();
+
+    /**
+     * Forgets sequence state, for example when the robot reconnects. Already
+     * recorded intervals are kept.
+     */
+    void resetSequence();
+
+    /**
+     * Returns statistics over the last kWindowSize intervals
+     */
+    Summary summary() const;
+
+    /**
+     * Writes every recorded interval to a CSV file
+     *
+     * @return false if the file couldn't be written
+     */
+    bool exportCsv(const std::string& fileName) const;
+
+private:
+    using steady_clock = std::chrono::steady_clock;
+
+    std::deque<Interval> m_history;
+    Interval m_current;
+
+    bool m_haveSequence = false;
+    uint32_t m_highestSequence = 0;
+
+    // Bit n is set if m_highestSequence - n was received
+    uint64_t m_received = 0;
+
+    /* Time of the interval which counted sequence s as lost, indexed by
+     * s % 64. Only valid for sequences missing from m_received.
+     */
+    std::array<uint32_t, 64> m_lostTime{};
+
+    // Arrival and send times of the previous packet in microseconds
+    int64_t m_lastArrival = 0;
+    uint32_t m_lastSendTime = 0;
+
+    // RFC 3550 interarrival jitter estimate in microseconds
+    double m_jitter = 0.0;
+
+    steady_clock::time_point m_startTime = steady_clock::now();
+};
@@ -2,9 +2,17 @@
 
 #include "MainWindow.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <cstdio>
 #include <cstring>
+#include <cwchar>
+#include <deque>
 #include <fstream>
+#include <iostream>
+#include <iterator>
+#include <unordered_map>
 #include <utility>
 
 #include <QHBoxLayout>
@@ -14,36 +22,14 @@
 
 #include "MJPEG/MjpegClient.hpp"
 #include "MJPEG/VideoStream.hpp"
+#include "NetWidgets/CanvasItem.hpp"
+#include "NetWidgets/ColumnCanvas.hpp"
+#include "NetWidgets/Graph.hpp"
 #include "NetWidgets/ProgressBar.hpp"
 #include "NetWidgets/StatusLight.hpp"
 #include "NetWidgets/Text.hpp"
 #include "Util.hpp"
 
-std::wstring replaceUnicodeChars(std::wstring text) {
-    size_t uPos = 0;
-
-    /* Replace all "\uXXXX" strings with the unicode character corresponding
-     * to the 32 bit code XXXX
-     */
-    while (uPos < text.length()) {
-        if (uPos == 0) {
-            uPos = text.find(L"\\u", uPos);
-        } else {
-            uPos = text.find(L"\\u", uPos + 1);
-        }
-
-        if (uPos < text.length() - 5) {
-            wchar_t num[2];
-            num[0] = std::stoi(text.substr(uPos + 2, 4), nullptr, 16);
-            num[1] = '\0';
-
-            text = text.replace(uPos, 6, num);
-        }
-    }
-
-    return text;
-}
-
 MainWindow::MainWindow(int width, int height) : m_buffer(0xffff - 28) {
     setMinimumSize(width, height);
 
@@ -80,19 +66,34 @@ MainWindow::MainWindow(int width, int height) : m_buffer(0xffff - 28) {
     buttonLayout->insertStretch(1);
     m_centerWidgetLayout->addLayout(buttonLayout, Qt::AlignHCenter);
 
+    m_linkStatus = new QLabel();
+    m_centerWidgetLayout->addWidget(m_linkStatus, 0, Qt::AlignTop);
+
     auto rightLayout = new QVBoxLayout();
 
     m_rightWidgetLayout = new QVBoxLayout();
 
+    /* Painting a column with one widget avoids the layout and paint overhead
+     * of a widget per element
+     */
+    if (m_settings->getString("renderMode") == "canvas") {
+        m_leftCanvas = new ColumnCanvas();
+        m_leftWidgetLayout->addWidget(m_leftCanvas);
+
+        m_rightCanvas = new ColumnCanvas();
+        m_rightWidgetLayout->addWidget(m_rightCanvas);
+    }
+
     m_autoSelect = new QComboBox();
     connect(m_autoSelect,
             static_cast<void (QComboBox::*)(int)>(&QComboBox::activated),
             [this](int index) {
-                char data[16] = "autonSelect\r\n";
-                data[13] = index;
+                char data[Protocol::kMaxHeaderSize + 1] = {};
+                size_t size = Protocol::encodeCommand(
+                    data, m_protocolVersion, Protocol::Opcode::AutonSelect);
+                data[size++] = index;
 
-                m_dataSocket->writeDatagram(data, sizeof(data), m_remoteIP,
-                                            m_dataPort);
+                m_dataSocket->writeDatagram(data, size, m_remoteIP, m_dataPort);
             });
     rightLayout->addWidget(m_autoSelect);
     rightLayout->addLayout(m_rightWidgetLayout);
@@ -110,7 +111,19 @@ MainWindow::MainWindow(int width, int height) : m_buffer(0xffff - 28) {
     mainLayout->addLayout(rightLayout, 0, 2);
     mainLayout->setAlignment(rightLayout, Qt::AlignTop);
 
-    centralWidget->setLayout(mainLayout);
+    m_pageTabs = new QTabBar();
+    m_pageTabs->hide();
+    connect(m_pageTabs, &QTabBar::currentChanged, [this](int index) {
+        if (index >= 0) {
+            showPage(index);
+        }
+    });
+
+    auto pageLayout = new QVBoxLayout();
+    pageLayout->addWidget(m_pageTabs);
+    pageLayout->addLayout(mainLayout);
+
+    centralWidget->setLayout(pageLayout);
 
     createActions();
     createMenus();
@@ -129,14 +142,72 @@ MainWindow::MainWindow(int width, int height) : m_buffer(0xffff - 28) {
     m_connectTimer = std::make_unique<QTimer>();
     connect(m_connectTimer.get(), &QTimer::timeout, [this] {
         if (!m_connectDlgOpen) {
-            char data[16] = "connect\r\n";
-            m_dataSocket->writeDatagram(data, sizeof(data), m_remoteIP,
-                                        m_dataPort);
+            // A rebooted robot may reuse the ID of the last transfer
+            m_guiAssembler.forgetCompleted();
+
+            // Offers the highest protocol version this display understands
+            char data[Protocol::kMaxHeaderSize] = {};
+            size_t size = Protocol::encodeCommand(data, Protocol::kVersion1,
+                                                  Protocol::Opcode::Connect);
+            m_dataSocket->writeDatagram(data, size, m_remoteIP, m_dataPort);
         }
 
         m_connectTimer->start(2000);
     });
     m_connectTimer->start(2000);
+
+    m_fragmentTimer = std::make_unique<QTimer>();
+    m_fragmentTimer->setSingleShot(true);
+    connect(m_fragmentTimer.get(), &QTimer::timeout,
+            [this] { requestMissingFragments(); });
+
+    // Every run of the display records to its own file
+    std::string telemetryPath = m_settings->getString("telemetryPath");
+    if (telemetryPath == "NOT_FOUND") {
+        telemetryPath = "Telemetry";
+    }
+    m_telemetryPath = QString::fromStdString(telemetryPath);
+    QDir telemetryDir(m_telemetryPath);
+    telemetryDir.mkpath(".");
+    m_recorder = std::make_unique<Recorder>(
+        telemetryDir
+            .filePath(QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss") +
+                      ".dstl")
+            .toStdString());
+
+    std::string layoutCachePath = m_settings->getString("layoutCachePath");
+    if (layoutCachePath == "NOT_FOUND") {
+        layoutCachePath = "LayoutCache";
+    }
+    m_layoutCachePath = QString::fromStdString(layoutCachePath);
+    QDir(m_layoutCachePath).mkpath(".");
+
+    m_replayTimer = std::make_unique<QTimer>();
+    connect(m_replayTimer.get(), &QTimer::timeout, [this] { pollReplay(); });
+
+    m_statusTimer = std::make_unique<QTimer>();
+    connect(m_statusTimer.get(), &QTimer::timeout,
+            [this] { updateLinkStatus(); });
+    m_statusTimer->start(1000);
+
+    // Updates faster than the monitor can show them would be wasted
+    double updateRate = m_settings->getDouble("updateRate");
+    if (!(updateRate > 0.0) && QGuiApplication::primaryScreen() != nullptr) {
+        updateRate = QGuiApplication::primaryScreen()->refreshRate();
+    }
+    if (!(updateRate > 0.0)) {
+        updateRate = 60.0;
+    }
+
+    /* A coarse timer may fire up to 5% late. Rounding the interval to the
+     * nearest millisecond comes closest to the configured rate.
+     */
+    m_updateTimer = std::make_unique<QTimer>();
+    m_updateTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_updateTimer.get(), &QTimer::timeout,
+            [this] { updateElements(); });
+    m_updateTimer->start(
+        std::max(1, static_cast<int>(std::lround(1000.0 / updateRate))));
 }
 
 void MainWindow::startMJPEG() { m_client->start(); }
@@ -161,76 +232,105 @@ void MainWindow::toggleButton() {
 
 void MainWindow::handleSocketData() {
     while (m_dataSocket->hasPendingDatagrams()) {
-        size_t packetPos = 0;
         m_buffer.resize(m_dataSocket->pendingDatagramSize());
         m_dataSocket->readDatagram(m_buffer.data(), m_buffer.size());
 
-        std::string header;
-        packetToVar(m_buffer, packetPos, header);
+        // The robot's packets would be mixed up with the recorded ones
+        if (m_replay != nullptr) {
+            continue;
+        }
+
+        processPacket(m_buffer);
+    }
+}
+
+void MainWindow::processPacket(std::vector<char>& packet) {
+    size_t packetPos = 0;
+
+    Protocol::Header header;
+    if (!Protocol::decodeHeader(packet.data(), packet.size(), packetPos,
+                                header)) {
+        return;
+    }
 
-        /* If this instance has connected to the server before, receiving any
-         * packet resets the timeout. This check is necessary in case a previous
-         * instance caused packets to be redirected here.
+    // Replies use whichever version the robot chose at connect
+    m_protocolVersion = header.version;
+
+    PacketReader reader(packet, packetPos);
+
+    /* If this instance has connected to the server before, receiving any
+     * packet resets the timeout. This check is necessary in case a previous
+     * instance caused packets to be redirected here.
+     */
+    if (m_connectedBefore && m_replay == nullptr) {
+        m_connectTimer->start(2000);
+    }
+
+    if (header.opcode == Protocol::Opcode::Display) {
+        /* Only allow keep-alive (resetting timer) if we have a valid
+         * GUI; we need to connect and create the GUI before accepting
+         * display data
          */
         if (m_connectedBefore) {
-            m_connectTimer->start(2000);
-        }
-
-        if (header == "display\r\n") {
-            /* Only allow keep-alive (resetting timer) if we have a valid
-             * GUI; we need to connect and create the GUI before accepting
-             * display data
-             */
-            if (m_connectedBefore) {
-                updateGuiTable(m_buffer, packetPos);
-                NetWidget::updateElements();
+            // Stale packets would overwrite newer values
+            if (m_protocolVersion >= Protocol::kVersion2 &&
+                !checkSequence(reader)) {
+                return;
             }
-        } else if (header == "guiCreate\r\n") {
-            reloadGUI(m_buffer, packetPos);
 
-            if (!m_connectedBefore) {
-                m_connectedBefore = true;
-            }
-        } else if (header == "autonList\r\n") {
-            /* Unpacks the following variables:
-             *
-             * Autonomous Modes (contained in rest of packet):
-             * std::string: autonomous routine name
-             * <more autonomous routine names>...
-             */
-
-            std::vector<std::string> autoNames;
-            std::string autoName;
-            while (packetPos < m_buffer.size() &&
-                   packetToVar(m_buffer, packetPos, autoName)) {
-                autoNames.emplace_back(autoName);
-            }
+            // Elements are updated by m_updateTimer
+            updateGuiTable(reader);
+            m_valuesChanged = true;
+        }
+    } else if (header.opcode == Protocol::Opcode::Record) {
+        if (m_connectedBefore && checkSequence(reader)) {
+            updateGuiRecord(reader);
+            m_valuesChanged = true;
+        }
+    } else if (header.opcode == Protocol::Opcode::GuiCreate) {
+        if (m_protocolVersion >= Protocol::kVersion2) {
+            receiveGuiFragment(reader);
+        } else {
+            createGUI(reader);
+        }
+    } else if (header.opcode == Protocol::Opcode::LayoutHash) {
+        receiveLayoutHash(reader);
+    } else if (header.opcode == Protocol::Opcode::AutonList) {
+        /* Unpacks the following variables:
+         *
+         * Autonomous Modes (contained in rest of packet):
+         * std::string: autonomous routine name
+         * <more autonomous routine names>...
+         */
 
-            m_autoSelect->clear();
-            for (auto& str : autoNames) {
-                m_autoSelect->addItem(str.c_str());
-            }
-        } else if (header == "autonConfirmed\r\n") {
-            /* If a new autonomous mode was selected from the robot, it
-             * sends back this packet as confirmation
-             */
-            std::string autoName = "Autonomous mode changed to\n";
-
-            std::string tempName;
-            packetToVar(m_buffer, packetPos, tempName);
-            autoName += tempName;
-
-            int idx = m_autoSelect->findText(QString::fromStdString(tempName));
-            if (idx != -1) {
-                m_autoSelect->setCurrentIndex(idx);
+        m_autoSelect->clear();
+        while (!reader.atEnd()) {
+            auto autoName = reader.readString();
+            if (reader.ok()) {
+                m_autoSelect->addItem(
+                    QString::fromUtf8(autoName.data(), autoName.size()));
             }
+        }
+    } else if (header.opcode == Protocol::Opcode::AutonConfirmed) {
+        /* If a new autonomous mode was selected from the robot, it
+         * sends back this packet as confirmation
+         */
+        std::string autoName = "Autonomous mode changed to\n";
 
-            QMessageBox* connectDlg = new QMessageBox(this);
-            connectDlg->setAttribute(Qt::WA_DeleteOnClose);
-            connectDlg->setWindowTitle("Autonomous Change");
-            connectDlg->setText(autoName.c_str());
-            connectDlg->open();
+        auto tempName = reader.readString();
+        autoName += tempName;
+
+        int idx = m_autoSelect->findText(
+            QString::fromUtf8(tempName.data(), tempName.size()));
+        if (idx != -1) {
+            m_autoSelect->setCurrentIndex(idx);
         }
+
+        QMessageBox* connectDlg = new QMessageBox(this);
+        connectDlg->setAttribute(Qt::WA_DeleteOnClose);
+        connectDlg->setWindowTitle("Autonomous Change");
+        connectDlg->setText(autoName.c_str());
+        connectDlg->open();
     }
 }
 
@@ -241,6 +341,40 @@ void MainWindow::createActions() {
     m_stopMJPEGAct = new QAction(tr("&Stop"), this);
     connect(m_stopMJPEGAct, SIGNAL(triggered()), this, SLOT(stopMJPEG()));
 
+    m_exportStatsAct = new QAction(tr("&Export Link Statistics..."), this);
+    connect(m_exportStatsAct, &QAction::triggered,
+            [this] { exportLinkStats(); });
+
+    m_replayAct = new QAction(tr("&Replay Telemetry..."), this);
+    connect(m_replayAct, &QAction::triggered, [this] { startReplay(); });
+
+    m_seekReplayAct = new QAction(tr("S&eek Replay..."), this);
+    m_seekReplayAct->setEnabled(false);
+    connect(m_seekReplayAct, &QAction::triggered, [this] { seekReplay(); });
+
+    m_stopReplayAct = new QAction(tr("Stop Re&play"), this);
+    m_stopReplayAct->setEnabled(false);
+    connect(m_stopReplayAct, &QAction::triggered, [this] { stopReplay(); });
+
+    // A speed of zero replays as fast as possible
+    m_replaySpeedGroup = new QActionGroup(this);
+    m_replaySpeedGroup->setExclusive(true);
+    for (auto speed : {1.0, 2.0, 10.0, 0.0}) {
+        auto action = new QAction(speed > 0.0 ? tr("%1x").arg(speed)
+                                              : tr("As Fast As Possible"),
+                                  this);
+        action->setCheckable(true);
+        action->setChecked(speed == m_replaySpeed);
+        connect(action, &QAction::triggered, [this, speed] {
+            m_replaySpeed = speed;
+            if (m_replay != nullptr) {
+                m_replay->setSpeed(speed);
+                m_replayTimer->start(speed > 0.0 ? 5 : 0);
+            }
+        });
+        m_replaySpeedGroup->addAction(action);
+    }
+
     m_exitAct = new QAction(tr("&Exit"), this);
     connect(m_exitAct, SIGNAL(triggered()), this, SLOT(close()));
 
@@ -253,212 +387,718 @@ void MainWindow::createMenus() {
     m_optionsMenu->addAction(m_startMJPEGAct);
     m_optionsMenu->addAction(m_stopMJPEGAct);
     m_optionsMenu->addSeparator();
+    m_optionsMenu->addAction(m_exportStatsAct);
+    m_optionsMenu->addSeparator();
+    m_optionsMenu->addAction(m_replayAct);
+    m_optionsMenu->addAction(m_seekReplayAct);
+    m_optionsMenu->addAction(m_stopReplayAct);
+    auto speedMenu = m_optionsMenu->addMenu(tr("Replay &Speed"));
+    for (auto action : m_replaySpeedGroup->actions()) {
+        speedMenu->addAction(action);
+    }
+    m_optionsMenu->addSeparator();
     m_optionsMenu->addAction(m_exitAct);
 
     m_helpMenu = menuBar()->addMenu(tr("&Help"));
     m_helpMenu->addAction(m_aboutAct);
 }
 
-void MainWindow::clearGUI() {
-    clearLayout(m_leftWidgetLayout);
-    clearLayout(m_rightWidgetLayout);
-}
-
-void MainWindow::clearLayout(QLayout* layout) {
-    QLayoutItem* item;
-    while ((item = layout->takeAt(0)) != nullptr) {
-        delete item->widget();
-        delete item;
+void MainWindow::reloadGUI(PacketReader& reader) {
+    // The file is parsed where it is in the packet
+    auto text = reader.readString();
+    if (m_replay == nullptr) {
+        m_recorder->addLayout(text);
     }
-}
 
-void MainWindow::reloadGUI(std::vector<char>& data, size_t& pos) {
-    // Remove old elements before creating new ones
-    clearGUI();
+    parseLayout(text);
+
+    /* Version 2 robots follow the file with the IDs they assigned to each
+     * key. Display packets use those IDs instead of key names.
+     */
+    if (m_protocolVersion >= Protocol::kVersion2) {
+        std::vector<std::string> keys;
+        auto keyCount = reader.read<uint16_t>();
+        keys.reserve(keyCount);
+
+        for (uint16_t i = 0; i < keyCount; i++) {
+            auto key = reader.readString();
+            if (!reader.ok()) {
+                break;
+            }
+            keys.emplace_back(key);
+        }
 
-    resetAllTemps();
+        NetWidget::setKeyIds(keys);
+    }
 
-    // Read the file into a string
-    std::string tmpbuf;
-    packetToVar(data, pos, tmpbuf);
+    // Version 4 robots then send where each key is in their records
+    if (m_protocolVersion >= Protocol::kVersion4) {
+        std::vector<NetWidget::RecordField> fields;
+        auto fieldCount = reader.read<uint16_t>();
+        fields.reserve(fieldCount);
+
+        for (uint16_t i = 0; i < fieldCount; i++) {
+            NetWidget::RecordField field;
+            field.keyId = reader.read<uint16_t>();
+            field.type =
+                static_cast<Protocol::ValueType>(reader.read<uint8_t>());
+            field.offset = reader.read<uint16_t>();
+            field.size = reader.read<uint16_t>();
+            if (!reader.ok()) {
+                break;
+            }
+            fields.push_back(field);
+        }
 
-    std::vector<std::string> lines = split(tmpbuf, "\n");
-    for (auto& str : lines) {
-        parseLine(str);
+        NetWidget::setRecordFields(std::move(fields));
     }
 }
 
 void MainWindow::reloadGUI(const std::string& fileName) {
     std::ifstream guiSettings(fileName);
 
-    // Remove old elements before creating new ones
-    clearGUI();
-
+    std::string text;
     if (guiSettings.is_open()) {
-        resetAllTemps();
+        text.assign(std::istreambuf_iterator<char>(guiSettings),
+                    std::istreambuf_iterator<char>());
+    }
 
-        while (!guiSettings.eof()) {
-            std::string temp;
-            std::getline(guiSettings, temp);
-            parseLine(std::move(temp));
+    parseLayout(text);
+}
+
+void MainWindow::parseLayout(std::string_view text) {
+    if (!m_layoutParser.parse(text)) {
+        for (const auto& error : m_layoutParser.getErrors()) {
+            std::cout << "GUISettings.txt:" << error.line << ":"
+                      << error.column << ": " << error.message << "\n";
         }
     }
-}
 
-void MainWindow::updateGuiTable(std::vector<char>& data, size_t& pos) {
-    NetWidget::updateValues(data, pos);
+    applyLayout(m_layoutParser.getElements(), m_layoutParser.getPages());
 }
 
-std::vector<std::string> MainWindow::split(const std::string& s,
-                                           const std::string& delim) {
-    std::vector<std::string> elems;
+void MainWindow::applyLayout(const std::vector<ElementDesc>& descs,
+                             const std::vector<std::wstring>& pages) {
+    updatePageTabs(pages);
 
-    size_t pos = 0;
-    size_t nextPos = 0;
-    while (nextPos != std::string::npos) {
-        nextPos = s.find_first_of(delim, pos);
-        elems.emplace_back(s.substr(pos, nextPos - pos));
-        pos = nextPos + delim.length();
+    /* The value table belongs to the layout. It's only cleared when the keys
+     * change, so an unchanged layout keeps its values across a reconnect.
+     */
+    bool sameKeys = std::equal(
+        descs.begin(), descs.end(), m_elements.begin(), m_elements.end(),
+        [](const ElementDesc& desc, const Element& element) {
+            return desc.keys == element.desc.keys;
+        });
+    if (!sameKeys) {
+        NetWidget::clearValues();
     }
 
-    return elems;
-}
-
-void MainWindow::parseLine(std::string line) {
-    m_tempVarIds.clear();
+    /* Keys on hidden pages get slots too, so their values are kept until the
+     * page is shown
+     */
+    for (const auto& desc : descs) {
+        for (const auto& key : desc.keys) {
+            NetWidget::internKey(key);
+        }
+    }
 
-    /* If the line doesn't have any characters in it, don't bother
-     * parsing it
+    /* Existing elements are reused in order for new ones with the same page,
+     * type, and column, so a layout which didn't change keeps every widget
      */
-    if (line.length() == 0) {
+    auto reuseKey = [](const ElementDesc& desc) {
+        return desc.page << 16 | static_cast<size_t>(desc.type) << 8 |
+               static_cast<size_t>(desc.column);
+    };
+    std::unordered_map<size_t, std::deque<size_t>> reusable;
+    for (size_t i = 0; i < m_elements.size(); i++) {
+        reusable[reuseKey(m_elements[i].desc)].push_back(i);
+    }
+
+    std::vector<bool> reused(m_elements.size(), false);
+    std::vector<Element> elements;
+    elements.reserve(descs.size());
+    for (const auto& desc : descs) {
+        auto& candidates = reusable[reuseKey(desc)];
+        if (candidates.empty()) {
+            // Elements on hidden pages are created when the page is shown
+            if (desc.page == m_currentPage) {
+                elements.emplace_back(createElement(desc));
+            } else {
+                elements.emplace_back();
+                elements.back().desc = desc;
+            }
+        } else {
+            size_t index = candidates.front();
+            candidates.pop_front();
+
+            reused[index] = true;
+            if (m_elements[index].netWidget != nullptr) {
+                updateElement(m_elements[index], desc, !sameKeys);
+            } else {
+                m_elements[index].desc = desc;
+            }
+            elements.emplace_back(std::move(m_elements[index]));
+        }
+    }
+
+    std::swap(m_elements, elements);
+
+    arrangeColumn(m_leftWidgetLayout, m_leftCanvas, ElementDesc::Column::Left);
+    arrangeColumn(m_rightWidgetLayout, m_rightCanvas,
+                  ElementDesc::Column::Right);
+
+    // The canvases no longer refer to the removed elements
+    for (size_t i = 0; i < elements.size(); i++) {
+        if (!reused[i]) {
+            delete elements[i].widget;
+            delete elements[i].item;
+        }
+    }
+}
+
+void MainWindow::updatePageTabs(const std::vector<std::wstring>& pages) {
+    if (pages == m_pageNames) {
         return;
     }
+    m_pageNames = pages;
+
+    if (m_currentPage >= pages.size()) {
+        m_currentPage = 0;
+    }
+
+    // Rebuilding the tabs would otherwise switch pages for every tab
+    m_pageTabs->blockSignals(true);
+    while (m_pageTabs->count() > 0) {
+        m_pageTabs->removeTab(0);
+    }
+    for (const auto& name : pages) {
+        m_pageTabs->addTab(name.empty() ? tr("Main")
+                                        : QString::fromStdWString(name));
+    }
+    m_pageTabs->setCurrentIndex(m_currentPage);
+    m_pageTabs->blockSignals(false);
 
-    m_start = 0;
+    m_pageTabs->setVisible(pages.size() > 1);
+}
+
+void MainWindow::showPage(size_t page) {
+    m_currentPage = page;
 
-    // Get five arguments
-    for (size_t i = 0; i < 5;) {
-        // First three arguments are delimited by a space
-        if (i == 0) {
-            m_delimiter = " ";
-        } else if (i == 1) {
-            m_delimiter = ", ";
-        } else if (i == 3) {
-            m_delimiter = "\"";
+    for (auto& element : m_elements) {
+        if (element.desc.page == page && element.netWidget == nullptr) {
+            element = createElement(element.desc);
         }
+    }
 
-        if (m_start == std::string::npos) {
-            return;
+    arrangeColumn(m_leftWidgetLayout, m_leftCanvas, ElementDesc::Column::Left);
+    arrangeColumn(m_rightWidgetLayout, m_rightCanvas,
+                  ElementDesc::Column::Right);
+}
+
+MainWindow::Element MainWindow::createElement(const ElementDesc& desc) {
+    Element element;
+
+    ColumnCanvas* canvas = desc.column == ElementDesc::Column::Left
+                               ? m_leftCanvas
+                               : m_rightCanvas;
+    if (canvas != nullptr) {
+        element.item = new CanvasItem(desc.type, canvas);
+        element.netWidget = element.item;
+    } else {
+        switch (desc.type) {
+            case ElementDesc::Type::Text: {
+                auto temp = new Text(true);
+                element.widget = temp;
+                element.netWidget = temp;
+                break;
+            }
+            case ElementDesc::Type::StatusLight: {
+                auto temp = new StatusLight(true);
+                element.widget = temp;
+                element.netWidget = temp;
+                break;
+            }
+            case ElementDesc::Type::ProgressBar: {
+                auto temp = new ProgressBar(true);
+                element.widget = temp;
+                element.netWidget = temp;
+                break;
+            }
+            case ElementDesc::Type::Graph: {
+                auto temp = new Graph(true);
+                element.widget = temp;
+                element.netWidget = temp;
+                break;
+            }
         }
+    }
 
-        // If not at the beginning of the string, advance to the next delimiter
-        if (i > 0) {
-            m_start = line.find_first_of(m_delimiter + " ", m_start);
+    // The default description has no text or keys to compare against
+    element.desc.type = desc.type;
+
+    updateElement(element, desc, true);
+    return element;
+}
+
+void MainWindow::updateElement(Element& element, const ElementDesc& desc,
+                               bool slotsDropped) {
+    if (desc.startText != element.desc.startText) {
+        if (element.item != nullptr) {
+            element.item->setString(desc.startText);
+        } else {
+            switch (desc.type) {
+                case ElementDesc::Type::Text:
+                    static_cast<Text*>(element.widget)
+                        ->setString(desc.startText);
+                    break;
+                case ElementDesc::Type::StatusLight:
+                    static_cast<StatusLight*>(element.widget)
+                        ->setString(desc.startText);
+                    break;
+                case ElementDesc::Type::ProgressBar:
+                    static_cast<ProgressBar*>(element.widget)
+                        ->setString(desc.startText);
+                    break;
+                case ElementDesc::Type::Graph:
+                    static_cast<Graph*>(element.widget)
+                        ->setString(desc.startText);
+                    break;
+            }
         }
+    }
+
+    if (desc.updateText != element.desc.updateText) {
+        element.netWidget->setUpdateText(desc.updateText);
 
-        if (m_start == std::string::npos) {
-            return;
+        // The update text holds the length of the time window in seconds
+        if (desc.type == ElementDesc::Type::Graph) {
+            double window = std::wcstod(desc.updateText.c_str(), nullptr);
+            if (element.item != nullptr) {
+                element.item->setWindow(window);
+            } else {
+                static_cast<Graph*>(element.widget)->setWindow(window);
+            }
         }
+    }
+
+    /* Keys are set last since graphs size their histories for the time
+     * window
+     */
+    if (slotsDropped || desc.keys != element.desc.keys ||
+        desc.updateText != element.desc.updateText) {
+        std::vector<std::string> keys = desc.keys;
+        element.netWidget->updateKeys(keys);
+    }
 
-        // Find next argument
-        m_start = line.find_first_not_of(m_delimiter + " ", m_start);
+    element.desc = desc;
+}
 
-        if (m_start == std::string::npos) {
-            return;
+void MainWindow::arrangeColumn(QVBoxLayout* layout, ColumnCanvas* canvas,
+                               ElementDesc::Column column) {
+    std::vector<QWidget*> widgets;
+    std::vector<CanvasItem*> items;
+    for (const auto& element : m_elements) {
+        if (element.desc.column != column || element.netWidget == nullptr) {
+            continue;
         }
 
-        // Find end of next argument
-        m_end = line.find_first_of(m_delimiter, m_start);
-
-        // Get current argument
-        if (i == 0) {
-            // lastType vars are updated when the column is found
-            m_currentType = line.substr(m_start, m_end - m_start);
-        } else if (i == 1) {
-            /* Add the next variable ID to a storage vector for adding to the
-             * element later
-             */
-            m_tempVarIds.push_back(line.substr(m_start, m_end - m_start));
-        } else if (i == 2) {
-            m_column = line.substr(m_start, m_end - m_start);
-        } else if (i == 3) {
-            std::string tempStr = line.substr(m_start, m_end - m_start);
-
-            // Convert std::string to std::wstring
-            m_startText.assign(tempStr.begin(), tempStr.end());
-        } else if (i == 4) {
-            std::string tempStr = line.substr(m_start, m_end - m_start);
-
-            // Convert std::string to std::wstring
-            m_updateText.assign(tempStr.begin(), tempStr.end());
+        // Values for hidden pages only go into the value table
+        bool visible = element.desc.page == m_currentPage;
+        element.netWidget->setActive(visible);
+        if (visible) {
+            widgets.emplace_back(element.widget);
+            items.emplace_back(element.item);
         }
+    }
 
-        // Move start past current argument
-        m_start = m_end;
+    // The canvas stays in the layout and only its items change
+    if (canvas != nullptr) {
+        canvas->setItems(std::move(items));
+        return;
+    }
 
-        // If there are more IDs to add, skip incrementing the field counter
-        if (!(i == 1 && line[m_start] == ',')) {
-            i++;
+    // Leave the layout alone if the order of its widgets didn't change
+    bool unchanged = layout->count() == static_cast<int>(widgets.size());
+    for (int i = 0; unchanged && i < layout->count(); i++) {
+        unchanged = layout->itemAt(i)->widget() == widgets[i];
+    }
+    if (!unchanged) {
+        QLayoutItem* item;
+        while ((item = layout->takeAt(0)) != nullptr) {
+            delete item;
+        }
+        for (auto widget : widgets) {
+            layout->addWidget(widget);
         }
     }
 
-    /* Replace all unicode escape characters in the string with their unicode
-     * equivalents
+    /* Widgets taken out of the layout are still children of the window, so
+     * they're hidden explicitly. This is done after the layout adopts new
+     * widgets so they aren't shown as top-level windows.
      */
-    m_startText = replaceUnicodeChars(m_startText);
-    m_updateText = replaceUnicodeChars(m_updateText);
+    for (const auto& element : m_elements) {
+        if (element.desc.column == column && element.widget != nullptr) {
+            element.widget->setVisible(element.desc.page == m_currentPage);
+        }
+    }
+}
 
-    NetWidget* netPtr = nullptr;
-    QWidget* qPtr = nullptr;
+void MainWindow::updateGuiTable(PacketReader& reader) {
+    // Replayed data is already recorded
+    NetWidget::updateValues(reader, m_protocolVersion,
+                            m_replay == nullptr ? m_recorder.get() : nullptr);
+}
 
-    // Create element
-    if (m_currentType == "TEXT") {
-        auto temp = new Text(true);
-        temp->setString(m_startText);
+void MainWindow::updateGuiRecord(PacketReader& reader) {
+    // Replayed data is already recorded
+    NetWidget::updateRecord(reader,
+                            m_replay == nullptr ? m_recorder.get() : nullptr);
+}
 
-        netPtr = temp;
-        qPtr = temp;
-    } else if (m_currentType == "STATUSLIGHT") {
-        auto temp = new StatusLight(true);
-        temp->setString(m_startText);
+void MainWindow::createGUI(PacketReader& reader) {
+    reloadGUI(reader);
+    m_haveKeyframe = false;
 
-        netPtr = temp;
-        qPtr = temp;
-    } else if (m_currentType == "PBAR") {
-        auto temp = new ProgressBar(true);
-        temp->setString(m_startText);
+    // The robot may have restarted its sequence numbers
+    m_linkStats.resetSequence();
 
-        netPtr = temp;
-        qPtr = temp;
+    if (!m_connectedBefore) {
+        m_connectedBefore = true;
     }
+}
+
+void MainWindow::receiveGuiFragment(PacketReader& reader) {
+    Protocol::FragmentHeader header;
+    size_t pos = reader.position();
+    if (!Protocol::decodeFragmentHeader(reader.data(), reader.size(), pos,
+                                        header)) {
+        return;
+    }
+    reader.skip(pos - reader.position());
 
-    /* Set update text and add the update variables to track if an element was
-     * created
+    /* A transfer in progress counts as activity. Otherwise, a connect
+     * sent before the GUI exists would restart a slow transfer.
      */
-    if (netPtr != nullptr) {
-        netPtr->setUpdateText(m_updateText);
-        netPtr->updateKeys(m_tempVarIds);
+    m_connectTimer->start(2000);
+    m_fragmentRetries = 0;
+
+    if (!m_guiAssembler.add(header, reader.data() + reader.position(),
+                            reader.remaining())) {
+        if (m_guiAssembler.isActive()) {
+            m_fragmentTimer->start(200);
+        }
+        return;
+    }
+
+    m_fragmentTimer->stop();
+
+    std::vector<char> body;
+    if (m_guiAssembler.take(body)) {
+        if (m_protocolVersion >= Protocol::kVersion3) {
+            cacheLayout(body);
+        }
+
+        PacketReader bodyReader(body);
+        createGUI(bodyReader);
+    }
+}
+
+void MainWindow::requestMissingFragments() {
+    if (!m_guiAssembler.isActive()) {
+        return;
+    }
+
+    // Give up on the transfer; the robot sends a new one on reconnect
+    if (++m_fragmentRetries > 10) {
+        m_guiAssembler.reset();
+        return;
+    }
+
+    auto indices = m_guiAssembler.missing(Protocol::kMaxResendIndices);
+
+    char command[Protocol::kMaxHeaderSize + 2 * sizeof(uint16_t) +
+                 Protocol::kMaxResendIndices * sizeof(uint16_t)];
+    size_t size = Protocol::encodeCommand(command, m_protocolVersion,
+                                          Protocol::Opcode::GuiResend);
+    Protocol::writeU16(command + size, m_guiAssembler.transferId());
+    Protocol::writeU16(command + size + 2, indices.size());
+    size += 2 * sizeof(uint16_t);
+
+    for (auto index : indices) {
+        Protocol::writeU16(command + size, index);
+        size += sizeof(uint16_t);
+    }
+
+    m_dataSocket->writeDatagram(command, size, m_remoteIP, m_dataPort);
+    m_fragmentTimer->start(200);
+}
+
+void MainWindow::receiveLayoutHash(PacketReader& reader) {
+    auto hash = reader.read<uint64_t>();
+    if (!reader.ok()) {
+        return;
     }
 
-    // Add widget to correct layout if it was created
-    if (qPtr != nullptr) {
-        if (m_column == "left") {
-            m_leftWidgetLayout->addWidget(qPtr);
-        } else if (m_column == "right") {
-            m_rightWidgetLayout->addWidget(qPtr);
+    std::ifstream file(layoutCacheFile(hash), std::ifstream::binary);
+    std::vector<char> payload{std::istreambuf_iterator<char>(file),
+                              std::istreambuf_iterator<char>()};
+
+    // Files which were truncated or corrupted count as misses
+    if (!payload.empty() &&
+        Protocol::layoutHash(payload.data(), payload.size()) == hash) {
+        file.close();
+
+        // The modification time orders files by use for pruning the cache
+        QFile cached(QString::fromStdString(layoutCacheFile(hash)));
+        if (cached.open(QIODevice::ReadWrite)) {
+            cached.setFileTime(QDateTime::currentDateTime(),
+                               QFileDevice::FileModificationTime);
         }
+
+        PacketReader payloadReader(payload);
+        createGUI(payloadReader);
+        return;
     }
+
+    char command[Protocol::kMaxHeaderSize + sizeof(uint64_t)];
+    size_t size = Protocol::encodeCommand(command, m_protocolVersion,
+                                          Protocol::Opcode::LayoutMiss);
+    Protocol::writeU64(command + size, hash);
+    size += sizeof(uint64_t);
+
+    m_dataSocket->writeDatagram(command, size, m_remoteIP, m_dataPort);
 }
 
-void MainWindow::resetAllTemps() {
-    m_substring.clear();
-    m_start = 0;
+void MainWindow::cacheLayout(const std::vector<char>& payload) {
+    uint64_t hash = Protocol::layoutHash(payload.data(), payload.size());
+
+    {
+        std::ofstream file(layoutCacheFile(hash),
+                           std::ofstream::binary | std::ofstream::trunc);
+        file.write(payload.data(), payload.size());
+    }
+
+    // Files are listed newest first
+    QDir dir(m_layoutCachePath);
+    auto files = dir.entryList({"*.layout"}, QDir::Files, QDir::Time);
+    for (int i = kMaxCachedLayouts; i < files.size(); i++) {
+        dir.remove(files[i]);
+    }
+}
+
+std::string MainWindow::layoutCacheFile(uint64_t hash) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.layout",
+                  static_cast<unsigned long long>(hash));
+    return QDir(m_layoutCachePath).filePath(name).toStdString();
+}
+
+bool MainWindow::checkSequence(PacketReader& reader) {
+    using namespace std::chrono_literals;
+
+    auto flags = reader.read<uint8_t>();
+    auto sequence = reader.read<uint32_t>();
+    auto sendTime = reader.read<uint32_t>();
+
+    // Packets too short for the fields are dropped
+    if (!reader.ok() ||
+        !m_linkStats.addPacket(sequence, sendTime, reader.size())) {
+        return false;
+    }
 
-    m_delimiter.clear();
+    if (flags & Protocol::kKeyframe) {
+        m_haveKeyframe = true;
+        m_keyframeSize = reader.size();
+    } else {
+        if (m_keyframeSize > reader.size()) {
+            m_linkStats.addBytesSaved(m_keyframeSize - reader.size());
+        }
+
+        /* A gap in the sequence means a delta was lost, so values on the
+         * display may be stale until the next keyframe. Request one early
+         * instead of waiting for the periodic one.
+         */
+        auto time = std::chrono::steady_clock::now();
+        if ((!m_haveKeyframe || sequence != m_lastSequence + 1) &&
+            time - m_lastResyncTime > 250ms) {
+            char command[Protocol::kMaxHeaderSize];
+            size_t size = Protocol::encodeCommand(command, m_protocolVersion,
+                                                  Protocol::Opcode::Resync);
+            m_dataSocket->writeDatagram(command, size, m_remoteIP, m_dataPort);
+
+            m_lastResyncTime = time;
+        }
+    }
+
+    m_lastSequence = sequence;
+    return true;
+}
+
+void MainWindow::updateLinkStatus() {
+    m_linkStats.tick();
+    auto summary = m_linkStats.summary();
+
+    QString replayStatus;
+    if (m_replay != nullptr) {
+        replayStatus =
+            tr("Replaying: %1 of %2 s\n")
+                .arg(m_replay->getPosition() / 1e6, 0, 'f', 1)
+                .arg(m_replay->getDuration() / 1e6, 0, 'f', 1);
+    }
+
+    QString recorderStatus;
+    if (m_recorder->hasFailed()) {
+        recorderStatus =
+            tr("Recording failed: couldn't write %1\n")
+                .arg(QString::fromStdString(m_recorder->getFileName()));
+    } else if (m_recorder->getDroppedBlocks() > 0) {
+        recorderStatus = tr("Recording dropped %1 blocks behind the disk\n")
+                             .arg(m_recorder->getDroppedBlocks());
+    }
+
+    m_linkStatus->setText(
+        replayStatus + recorderStatus +
+        QString("Loss: %1%  Reordered: %2  Jitter: %3 ms\n"
+                "Received: %4 KiB/s  Saved by delta encoding: %5 KiB/s\n"
+                "Display updates: %6/s")
+            .arg(summary.lossPercent, 0, 'f', 1)
+            .arg(summary.reordered)
+            .arg(summary.jitter, 0, 'f', 2)
+            .arg(summary.bytesPerSecond / 1024.0, 0, 'f', 1)
+            .arg(summary.savedPerSecond / 1024.0, 0, 'f', 1)
+            .arg(m_elementUpdates));
+
+    // This is called once per second
+    m_elementUpdates = 0;
+}
+
+void MainWindow::updateElements() {
+    if (!m_valuesChanged) {
+        return;
+    }
+    m_valuesChanged = false;
+
+    /* Qt already combines the update() calls of every element into one
+     * repaint per event loop iteration. Disabling updates around this would
+     * discard their damaged regions and repaint the whole window instead.
+     */
+    NetWidget::updateElements();
+
+    m_elementUpdates++;
+}
+
+void MainWindow::exportLinkStats() {
+    QString fileName = QFileDialog::getSaveFileName(
+        this, tr("Export Link Statistics"), "LinkStats.csv",
+        tr("CSV files (*.csv)"));
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    if (!m_linkStats.exportCsv(fileName.toStdString())) {
+        QMessageBox::warning(this, tr("Export Link Statistics"),
+                             tr("Couldn't write %1").arg(fileName));
+    }
+}
+
+void MainWindow::startReplay() {
+    QString fileName = QFileDialog::getOpenFileName(
+        this, tr("Replay Telemetry"), m_telemetryPath,
+        tr("Telemetry files (*.dstl)"));
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    Reader reader;
+    if (!reader.open(fileName.toStdString())) {
+        QMessageBox::warning(this, tr("Replay Telemetry"),
+                             tr("%1 isn't a telemetry file").arg(fileName));
+        return;
+    }
+    if (reader.isTruncated()) {
+        QMessageBox::warning(
+            this, tr("Replay Telemetry"),
+            tr("%1 is damaged. Only the data before the damage will be "
+               "replayed.")
+                .arg(fileName));
+    }
+
+    stopReplay();
+
+    m_replay = std::make_unique<Replay>(reader);
+    m_replay->setSpeed(m_replaySpeed);
+
+    // Stop talking to the robot until the replay is done
+    m_connectTimer->stop();
+    m_fragmentTimer->stop();
+    m_guiAssembler.reset();
+    m_connectedBefore = false;
+
+    m_seekReplayAct->setEnabled(true);
+    m_stopReplayAct->setEnabled(true);
+    m_replayTimer->start(m_replaySpeed > 0.0 ? 5 : 0);
+}
+
+void MainWindow::seekReplay() {
+    if (m_replay == nullptr) {
+        return;
+    }
+
+    bool ok = false;
+    double seconds = QInputDialog::getDouble(
+        this, tr("Seek Replay"), tr("Time (s):"),
+        m_replay->getPosition() / 1e6, 0.0, m_replay->getDuration() / 1e6, 1,
+        &ok);
+    if (ok) {
+        m_replay->seek(static_cast<uint64_t>(seconds * 1e6));
+    }
+}
+
+void MainWindow::stopReplay() {
+    if (m_replay == nullptr) {
+        return;
+    }
+
+    m_replayTimer->stop();
+    m_replay = nullptr;
+
+    m_seekReplayAct->setEnabled(false);
+    m_stopReplayAct->setEnabled(false);
+
+    // The replayed GUI stays up until the robot sends its own
+    m_connectedBefore = false;
+    m_connectTimer->start(2000);
+}
+
+void MainWindow::pollReplay() {
+    /* As fast as possible, elements are updated after every packet instead of
+     * by m_updateTimer, so the measured throughput includes updating them.
+     * Repainting still happens between calls to poll().
+     */
+    bool asFastAsPossible = m_replay->getSpeed() <= 0.0;
+    if (m_replay->poll([this, asFastAsPossible](std::vector<char>& packet) {
+            processPacket(packet);
+            if (asFastAsPossible) {
+                updateElements();
+            }
+        })) {
+        return;
+    }
+
+    // An empty replay takes no time, so it has no rates to report
+    const auto& throughput = m_replay->getThroughput();
+    if (asFastAsPossible && throughput.seconds > 0.0) {
+        QMessageBox::information(
+            this, tr("Replay Telemetry"),
+            tr("Replayed %1 packets (%2 KiB) in %3 s: %4 packets/s, "
+               "%5 MiB/s")
+                .arg(throughput.packets)
+                .arg(throughput.bytes / 1024)
+                .arg(throughput.seconds, 0, 'f', 3)
+                .arg(throughput.packets / throughput.seconds, 0, 'f', 0)
+                .arg(throughput.bytes / throughput.seconds / (1 << 20), 0,
+                     'f', 1));
+    }
 
-    m_currentType.clear();
-    m_column.clear();
-    m_startText.clear();
-    m_updateText.clear();
-    m_tempVarIds.clear();
+    stopReplay();
 }
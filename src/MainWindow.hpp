@@ -2,8 +2,10 @@
 
 #pragma once
 
+#include <chrono>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <QComboBox>
@@ -13,15 +15,28 @@
 #include <QUdpSocket>
 #include <QVBoxLayout>
 
+#include "DSDisplay/Protocol.hpp"
+#include "FragmentAssembler.hpp"
+#include "LayoutParser.hpp"
+#include "LinkStats.hpp"
+#include "PacketReader.hpp"
 #include "MJPEG/WindowCallbacks.hpp"
 #include "MJPEG/mjpeg_sck.hpp"
 #include "Settings.hpp"
+#include "Telemetry/Recorder.hpp"
+#include "Telemetry/Replay.hpp"
 
+class CanvasItem;
 class ClientBase;
+class ColumnCanvas;
+class NetWidget;
 class QAction;
+class QActionGroup;
+class QLabel;
 class QMenu;
 class QPushButton;
 class QSlider;
+class QTabBar;
 class VideoStream;
 
 /**
@@ -43,23 +58,78 @@ private slots:
     void handleSocketData();
 
 private:
+    // Handles one packet from the robot or a replay
+    void processPacket(std::vector<char>& packet);
+
     void createActions();
     void createMenus();
 
-    // Clears left and right layout
-    void clearGUI();
-
-    // Clears a specific layout
-    void clearLayout(QLayout* layout);
+    // Updates list of elements from packet
+    void reloadGUI(PacketReader& reader);
 
-    // Updates list of elements from packet and recreates them
-    void reloadGUI(std::vector<char>& data, size_t& pos);
-
-    // Updates list of elements from file and recreates them
+    // Updates list of elements from file
     void reloadGUI(const std::string& fileName);
 
     // Updates values of elements from packet
-    void updateGuiTable(std::vector<char>& data, size_t& pos);
+    void updateGuiTable(PacketReader& reader);
+
+    // Updates values of elements from a version 4 record
+    void updateGuiRecord(PacketReader& reader);
+
+    // Recreates the GUI from a guiCreate payload
+    void createGUI(PacketReader& reader);
+
+    /* Adds a version 2 guiCreate fragment to the transfer in progress and
+     * creates the GUI once all fragments have arrived
+     */
+    void receiveGuiFragment(PacketReader& reader);
+
+    // Asks the robot to resend fragments which haven't arrived yet
+    void requestMissingFragments();
+
+    /* Creates the GUI from the layout cache if it has the payload with the
+     * robot's hash, or asks the robot for the payload otherwise
+     */
+    void receiveLayoutHash(PacketReader& reader);
+
+    /* Saves a guiCreate payload in the layout cache and removes the least
+     * recently used files beyond kMaxCachedLayouts
+     */
+    void cacheLayout(const std::vector<char>& payload);
+
+    // Returns the name of the layout cache file for a payload hash
+    std::string layoutCacheFile(uint64_t hash) const;
+
+    /* Reads the flags, sequence number, and send time of a version 2 display
+     * packet and asks the robot for a keyframe if a packet was lost
+     *
+     * Returns false if the packet is older than one already applied and should
+     * be dropped.
+     */
+    bool checkSequence(PacketReader& reader);
+
+    // Shows link statistics in the status panel
+    void updateLinkStatus();
+
+    /* Applies values received since the last call to the elements in one
+     * batch
+     */
+    void updateElements();
+
+    // Asks for a file name and writes the link statistics history to it
+    void exportLinkStats();
+
+    // Asks for a recorded session and plays it back instead of the robot
+    void startReplay();
+
+    // Asks for a time and moves the replay there
+    void seekReplay();
+
+    // Returns to receiving from the robot
+    void stopReplay();
+
+    // Feeds the packets which are due to processPacket()
+    void pollReplay();
 
     std::unique_ptr<Settings> m_settings;
 
@@ -71,6 +141,14 @@ private:
     // Allows the user to select which autonomous mode the robot shoud run
     QComboBox* m_autoSelect;
 
+    // Selects the page of elements shown. Hidden if there's only one page.
+    QTabBar* m_pageTabs;
+
+    // Names of the pages the tabs were created for
+    std::vector<std::wstring> m_pageNames;
+
+    size_t m_currentPage = 0;
+
     // Holds dynamically created widgets in left column
     QVBoxLayout* m_leftWidgetLayout;
 
@@ -80,10 +158,21 @@ private:
     // Holds dynamically created widgets in right column
     QVBoxLayout* m_rightWidgetLayout;
 
+    /* Paint the elements of each column when renderMode in IPSettings.txt is
+     * "canvas", or nullptr if every element is its own widget
+     */
+    ColumnCanvas* m_leftCanvas = nullptr;
+    ColumnCanvas* m_rightCanvas = nullptr;
+
     QMenu* m_optionsMenu;
     QMenu* m_helpMenu;
     QAction* m_startMJPEGAct;
     QAction* m_stopMJPEGAct;
+    QAction* m_exportStatsAct;
+    QAction* m_replayAct;
+    QAction* m_seekReplayAct;
+    QAction* m_stopReplayAct;
+    QActionGroup* m_replaySpeedGroup;
     QAction* m_exitAct;
     QAction* m_aboutAct;
 
@@ -93,32 +182,121 @@ private:
     bool m_connectDlgOpen{false};
     bool m_connectedBefore{false};
 
+    // Protocol version the robot answered with
+    uint8_t m_protocolVersion = Protocol::kVersion1;
+
     std::vector<char> m_buffer;
 
     std::unique_ptr<QTimer> m_connectTimer;
 
-    // DisplaySettings
-    std::string m_substring;
-    size_t m_start;
-    size_t m_end;
+    // Sequence number of the last version 2 display packet
+    uint32_t m_lastSequence = 0;
 
-    std::string m_delimiter;
+    // True if all values are known since the GUI was last created
+    bool m_haveKeyframe = false;
 
-    std::string m_currentType;
-    std::string m_column;
-    std::wstring m_startText;
-    std::wstring m_updateText;
-    std::vector<std::string> m_tempVarIds;
+    // Rate-limits keyframe requests
+    std::chrono::steady_clock::time_point m_lastResyncTime;
 
-    std::vector<std::string> split(const std::string& s,
-                                   const std::string& delim);
+    // Size of the last keyframe, used to estimate what deltas saved
+    size_t m_keyframeSize = 0;
 
-    /* Parses a given settings line, adding an element if applicable and
-     * incrementing the global position variables for the column to which
-     * the element was added
+    // Loss, reorder, jitter, and bandwidth of version 2 display packets
+    LinkStats m_linkStats;
+    QLabel* m_linkStatus;
+    std::unique_ptr<QTimer> m_statusTimer;
+
+    /* Updates elements at most once per refresh of the monitor, or at the
+     * rate set by updateRate in IPSettings.txt
+     */
+    std::unique_ptr<QTimer> m_updateTimer;
+
+    // Set when display data arrives and cleared when elements are updated
+    bool m_valuesChanged = false;
+
+    // Number of element updates since the link status was last shown
+    uint32_t m_elementUpdates = 0;
+
+    // Records every display packet and GUI layout received
+    std::unique_ptr<Recorder> m_recorder;
+    QString m_telemetryPath;
+
+    /* Directory of guiCreate payloads received from version 3 robots. Only
+     * the most recently used kMaxCachedLayouts files are kept.
      */
-    void parseLine(std::string line);
+    QString m_layoutCachePath;
+    static constexpr int kMaxCachedLayouts = 32;
+
+    // Session being played back instead of the robot's packets, if any
+    std::unique_ptr<Replay> m_replay;
+    std::unique_ptr<QTimer> m_replayTimer;
+
+    // Multiple of real time, or zero for as fast as possible
+    double m_replaySpeed = 1.0;
+
+    // Reassembles fragmented guiCreate transfers
+    FragmentAssembler m_guiAssembler;
+
+    // Fires when fragments of a transfer stop arriving
+    std::unique_ptr<QTimer> m_fragmentTimer;
+
+    /* Number of consecutive requests for missing fragments which went
+     * unanswered
+     */
+    int m_fragmentRetries = 0;
+
+    LayoutParser m_layoutParser;
+
+    struct Element {
+        // Description the widget currently reflects
+        ElementDesc desc;
+
+        // Set if the element is a widget
+        QWidget* widget = nullptr;
 
-    // Resets all temporary variables to be reused during a call to update(1)
-    void resetAllTemps();
+        // Set if the element is drawn by a column canvas
+        CanvasItem* item = nullptr;
+
+        // nullptr until the element's page is first shown
+        NetWidget* netWidget = nullptr;
+    };
+
+    // Elements in the order they appear in GUISettings.txt
+    std::vector<Element> m_elements;
+
+    /* Updates the elements to match the given descriptions. Widgets are only
+     * created or deleted for elements which were added or removed, and
+     * changed ones are updated in place.
+     */
+    void applyLayout(const std::vector<ElementDesc>& descs,
+                     const std::vector<std::wstring>& pages);
+
+    // Recreates the page tabs if the page names changed
+    void updatePageTabs(const std::vector<std::wstring>& pages);
+
+    /* Shows the elements on the page, creating them if it's the first time
+     * the page is shown
+     */
+    void showPage(size_t page);
+
+    Element createElement(const ElementDesc& desc);
+
+    /* Applies the parts of desc which differ from the element's description.
+     * If slotsDropped is set, the keys are looked up again even if they
+     * didn't change.
+     */
+    void updateElement(Element& element, const ElementDesc& desc,
+                       bool slotsDropped);
+
+    /* Puts the column's widgets on the current page into the layout, or its
+     * items into the canvas, in element order. Elements on other pages are
+     * hidden and stop updating.
+     */
+    void arrangeColumn(QVBoxLayout* layout, ColumnCanvas* canvas,
+                       ElementDesc::Column column);
+
+    /* Parses GUISettings.txt text and applies it, reporting malformed lines
+     * to standard output
+     */
+    void parseLayout(std::string_view text);
 };
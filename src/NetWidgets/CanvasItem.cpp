@@ -0,0 +1,176 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#include "CanvasItem.hpp"
+
+#include <algorithm>
+
+#include <QBrush>
+#include <QPen>
+
+#include "CircleWidget.hpp"
+#include "ColumnCanvas.hpp"
+
+namespace {
+// Sizes match the widgets the items stand in for
+constexpr int kMargin = 2;
+constexpr int kLightSize = 25;
+constexpr int kBarHeight = 20;
+constexpr int kGraphHeight = 100;
+}  // namespace
+
+CanvasItem::CanvasItem(ElementDesc::Type type, ColumnCanvas* canvas)
+    : NetWidget(true), m_type(type), m_canvas(canvas) {
+    m_value = m_type == ElementDesc::Type::StatusLight ? CircleWidget::inactive
+                                                        : 0;
+}
+
+ElementDesc::Type CanvasItem::getType() const { return m_type; }
+
+void CanvasItem::setString(const std::wstring& text) {
+    if (m_type == ElementDesc::Type::Graph) {
+        m_plot.setTitle(text);
+        damage();
+    } else {
+        setText(QString::fromStdWString(text));
+    }
+}
+
+void CanvasItem::setWindow(double seconds) { m_plot.setWindow(seconds); }
+
+const std::vector<std::string>& CanvasItem::getKeys() const {
+    return m_varIds;
+}
+
+void CanvasItem::updateKeys(std::vector<std::string>& keys) {
+    NetWidget::updateKeys(keys);
+
+    if (m_type == ElementDesc::Type::Graph) {
+        m_plot.setKeys(keys);
+    }
+}
+
+void CanvasItem::updateEntry() {
+    switch (m_type) {
+        case ElementDesc::Type::Text: {
+            // The start text stays until the first value arrives
+            if (hasVarEntry(0)) {
+                setText(fillEntry(getVarEntry(0)));
+            }
+            break;
+        }
+        case ElementDesc::Type::StatusLight:
+            setValue(toInt(getVarEntry(0)));
+            break;
+        case ElementDesc::Type::ProgressBar:
+            setText(fillEntry(getVarEntry(0)));
+            setValue(std::clamp(toInt(getVarEntry(1)), 0, 100));
+            break;
+        case ElementDesc::Type::Graph:
+            // The canvas redraws graphs when their histories receive samples
+            break;
+    }
+}
+
+int CanvasItem::getHeight(int lineHeight) const {
+    switch (m_type) {
+        case ElementDesc::Type::Text:
+            return lineHeight + 2 * kMargin;
+        case ElementDesc::Type::StatusLight:
+            return std::max(kLightSize, lineHeight) + 2 * kMargin;
+        case ElementDesc::Type::ProgressBar:
+            return kBarHeight + lineHeight + 3 * kMargin;
+        case ElementDesc::Type::Graph:
+            return kGraphHeight;
+    }
+
+    return 0;
+}
+
+void CanvasItem::setRect(const QRect& rect) { m_rect = rect; }
+
+const QRect& CanvasItem::getRect() const { return m_rect; }
+
+void CanvasItem::paint(QPainter& painter, const QPalette& palette) {
+    int ascent = painter.fontMetrics().ascent();
+    int lineHeight = painter.fontMetrics().height();
+
+    switch (m_type) {
+        case ElementDesc::Type::Text:
+            painter.setPen(palette.color(QPalette::WindowText));
+            painter.drawText(m_rect.left() + kMargin,
+                             m_rect.top() + kMargin + ascent, m_text);
+            break;
+        case ElementDesc::Type::StatusLight: {
+            // Same colors as CircleWidget
+            QColor color(255, 0, 0);
+            if (m_value == CircleWidget::active) {
+                color = QColor(0, 255, 0);
+            } else if (m_value == CircleWidget::standby) {
+                color = QColor(255, 255, 0);
+            }
+
+            int centerX = m_rect.left() + kMargin + kLightSize / 2;
+            int centerY = m_rect.top() + m_rect.height() / 2;
+            painter.setPen(QColor(50, 50, 50));
+            painter.setBrush(QBrush(QColor(50, 50, 50)));
+            painter.drawEllipse(centerX - 12, centerY - 12, 24, 24);
+            painter.setPen(color);
+            painter.setBrush(QBrush(color));
+            painter.drawEllipse(centerX - 10, centerY - 10, 20, 20);
+
+            painter.setPen(palette.color(QPalette::WindowText));
+            painter.drawText(m_rect.left() + 2 * kMargin + kLightSize,
+                             centerY - lineHeight / 2 + ascent, m_text);
+            break;
+        }
+        case ElementDesc::Type::ProgressBar: {
+            QRect bar(m_rect.left() + kMargin, m_rect.top() + kMargin,
+                      m_rect.width() - 2 * kMargin, kBarHeight);
+            painter.fillRect(bar, palette.color(QPalette::Base));
+            painter.fillRect(QRect(bar.left(), bar.top(),
+                                   bar.width() * m_value / 100, bar.height()),
+                             palette.color(QPalette::Highlight));
+            painter.setPen(palette.color(QPalette::Mid));
+            painter.setBrush(QBrush());
+            painter.drawRect(bar);
+
+            painter.setPen(palette.color(QPalette::Text));
+            painter.drawText(bar, Qt::AlignCenter,
+                             QString::number(m_value) + "%");
+
+            painter.setPen(palette.color(QPalette::WindowText));
+            painter.drawText(m_rect.left() + kMargin,
+                             bar.bottom() + kMargin + ascent, m_text);
+            break;
+        }
+        case ElementDesc::Type::Graph:
+            m_plot.paint(painter, m_rect);
+            break;
+    }
+}
+
+void CanvasItem::redrawGraph() {
+    if (m_type == ElementDesc::Type::Graph && m_plot.needsRedraw()) {
+        damage();
+    }
+}
+
+void CanvasItem::setText(const QString& text) {
+    if (text != m_text) {
+        m_text = text;
+        damage();
+    }
+}
+
+void CanvasItem::setValue(int32_t value) {
+    if (value != m_value) {
+        m_value = value;
+        damage();
+    }
+}
+
+void CanvasItem::damage() {
+    if (!m_rect.isEmpty()) {
+        m_canvas->update(m_rect);
+    }
+}
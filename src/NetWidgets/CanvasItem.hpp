@@ -0,0 +1,88 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include <QPainter>
+#include <QPalette>
+#include <QRect>
+#include <QString>
+
+#include "../LayoutParser.hpp"
+#include "GraphPlot.hpp"
+#include "NetWidget.hpp"
+
+class ColumnCanvas;
+
+/**
+ * Element drawn by a ColumnCanvas instead of being a widget of its own
+ *
+ * Items only store what they show. When that changes, they ask the canvas to
+ * repaint their own rectangle.
+ */
+class CanvasItem : public NetWidget {
+public:
+    CanvasItem(ElementDesc::Type type, ColumnCanvas* canvas);
+
+    ElementDesc::Type getType() const;
+
+    /**
+     * Sets the text shown until values arrive, or the title of a graph
+     */
+    void setString(const std::wstring& text);
+
+    /**
+     * Sets the time window of a graph in seconds
+     */
+    void setWindow(double seconds);
+
+    /**
+     * Returns the keys the item shows the values of
+     */
+    const std::vector<std::string>& getKeys() const;
+
+    void updateKeys(std::vector<std::string>& keys) override;
+
+    void updateEntry() override;
+
+    /**
+     * Returns the height the item needs for the given font line height
+     */
+    int getHeight(int lineHeight) const;
+
+    /**
+     * Sets the item's position in the canvas. Called by ColumnCanvas.
+     */
+    void setRect(const QRect& rect);
+    const QRect& getRect() const;
+
+    void paint(QPainter& painter, const QPalette& palette);
+
+    /**
+     * Repaints a graph if it has samples to draw or scroll
+     */
+    void redrawGraph();
+
+private:
+    ElementDesc::Type m_type;
+    ColumnCanvas* m_canvas;
+    QRect m_rect;
+
+    QString m_text;
+
+    // Status of a status light or percentage of a progress bar
+    int32_t m_value;
+
+    // Only used by graphs
+    GraphPlot m_plot;
+
+    void setText(const QString& text);
+    void setValue(int32_t value);
+
+    // Asks the canvas to repaint the item's rectangle
+    void damage();
+};
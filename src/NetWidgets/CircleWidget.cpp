@@ -3,7 +3,6 @@
 #include "CircleWidget.hpp"
 
 #include <cstring>
-#include <type_traits>
 
 #include <QBrush>
 #include <QPainter>
@@ -11,10 +10,10 @@
 
 CircleWidget::CircleWidget(bool netUpdate, QWidget* parent)
     : QWidget(parent), NetWidget(netUpdate) {
-    setActive(Status::inactive);
+    setStatus(Status::inactive);
 }
 
-void CircleWidget::setActive(Status newStatus) {
+void CircleWidget::setStatus(Status newStatus) {
     if (newStatus == Status::active) {
         m_color = QColor(0, 255, 0);
     } else if (newStatus == Status::standby) {
@@ -26,27 +25,13 @@ void CircleWidget::setActive(Status newStatus) {
     m_status = newStatus;
 }
 
-CircleWidget::Status CircleWidget::getActive() { return m_status; }
+CircleWidget::Status CircleWidget::getStatus() { return m_status; }
 
 QSize CircleWidget::sizeHint() const { return QSize(25, 25); }
 
 void CircleWidget::updateEntry() {
-    NetEntry& lightEntry = getEntry(m_varIds[0]);
-
-    std::visit(
-        [&](auto&& arg) {
-            int32_t value;
-            using T = std::decay_t<decltype(arg)>;
-
-            if constexpr (std::is_same_v<T, int32_t>) {
-                value = std::get<int32_t>(lightEntry);
-            } else {
-                value = std::stoi(std::get<std::wstring>(lightEntry));
-            }
-            setActive(static_cast<Status>(value));
-            update();
-        },
-        lightEntry);
+    setStatus(static_cast<Status>(toInt(getVarEntry(0))));
+    update();
 }
 
 void CircleWidget::paintEvent(QPaintEvent* event) {
@@ -17,8 +17,8 @@ public:
 
     explicit CircleWidget(bool netUpdate, QWidget* parent = nullptr);
 
-    void setActive(Status newStatus);
-    Status getActive();
+    void setStatus(Status newStatus);
+    Status getStatus();
 
     QSize sizeHint() const;
 
@@ -0,0 +1,133 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#include "ColumnCanvas.hpp"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include <QHelpEvent>
+#include <QPaintEvent>
+#include <QPainter>
+#include <QToolTip>
+
+#include "CanvasItem.hpp"
+#include "GraphPlot.hpp"
+
+ColumnCanvas::ColumnCanvas(QWidget* parent) : QWidget(parent) {
+    // Every pixel is drawn by paintEvent(), so Qt needn't erase first
+    setAttribute(Qt::WA_OpaquePaintEvent);
+
+    m_redrawTimer = new QTimer(this);
+    connect(m_redrawTimer, &QTimer::timeout, [this] {
+        for (auto graph : m_graphs) {
+            graph->redrawGraph();
+        }
+    });
+    m_redrawTimer->start(GraphPlot::kRedrawPeriod);
+}
+
+void ColumnCanvas::setItems(std::vector<CanvasItem*> items) {
+    bool changed = items != m_items;
+    m_items = std::move(items);
+
+    m_graphs.clear();
+    for (auto item : m_items) {
+        if (item->getType() == ElementDesc::Type::Graph) {
+            m_graphs.emplace_back(item);
+        }
+    }
+
+    if (relayout() || changed) {
+        updateGeometry();
+        update();
+    }
+}
+
+CanvasItem* ColumnCanvas::itemAt(const QPoint& pos) const {
+    // Items are stacked, so their bottom edges are sorted
+    auto it = std::lower_bound(
+        m_items.begin(), m_items.end(), pos.y(),
+        [](CanvasItem* item, int y) { return item->getRect().bottom() < y; });
+    if (it != m_items.end() && (*it)->getRect().contains(pos)) {
+        return *it;
+    } else {
+        return nullptr;
+    }
+}
+
+QSize ColumnCanvas::sizeHint() const { return QSize(200, m_height); }
+
+bool ColumnCanvas::event(QEvent* event) {
+    if (event->type() == QEvent::ToolTip) {
+        auto helpEvent = static_cast<QHelpEvent*>(event);
+
+        CanvasItem* item = itemAt(helpEvent->pos());
+        if (item != nullptr) {
+            std::string keys;
+            for (const auto& key : item->getKeys()) {
+                if (!keys.empty()) {
+                    keys += ", ";
+                }
+                keys += key;
+            }
+            QToolTip::showText(helpEvent->globalPos(),
+                               QString::fromStdString(keys), this,
+                               item->getRect());
+        } else {
+            QToolTip::hideText();
+            event->ignore();
+        }
+
+        return true;
+    }
+
+    return QWidget::event(event);
+}
+
+void ColumnCanvas::paintEvent(QPaintEvent* event) {
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    const QRect& damaged = event->rect();
+    painter.fillRect(damaged, palette().color(QPalette::Window));
+
+    for (auto item : m_items) {
+        if (item->getRect().top() > damaged.bottom()) {
+            break;
+        }
+        if (item->getRect().intersects(damaged)) {
+            item->paint(painter, palette());
+        }
+    }
+}
+
+void ColumnCanvas::resizeEvent(QResizeEvent* event) {
+    QWidget::resizeEvent(event);
+
+    if (relayout()) {
+        update();
+    }
+}
+
+bool ColumnCanvas::relayout() {
+    int lineHeight = fontMetrics().height();
+
+    bool changed = false;
+    int y = 0;
+    for (auto item : m_items) {
+        QRect rect(0, y, width(), item->getHeight(lineHeight));
+        if (rect != item->getRect()) {
+            item->setRect(rect);
+            changed = true;
+        }
+        y += rect.height();
+    }
+
+    if (y != m_height) {
+        m_height = y;
+        changed = true;
+    }
+
+    return changed;
+}
@@ -0,0 +1,57 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#pragma once
+
+#include <vector>
+
+#include <QTimer>
+#include <QWidget>
+
+class CanvasItem;
+
+/**
+ * Paints a column of elements with a single widget
+ *
+ * Elements are stacked top to bottom in the order they're given. Each one only
+ * repaints its own rectangle when it changes, and a paint event only draws the
+ * items that intersect the damaged region.
+ */
+class ColumnCanvas : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit ColumnCanvas(QWidget* parent = nullptr);
+
+    /**
+     * Sets the items drawn in the column, top to bottom
+     *
+     * The canvas doesn't own the items. This must be called again before any
+     * of them are deleted.
+     */
+    void setItems(std::vector<CanvasItem*> items);
+
+    /**
+     * Returns the item at the given position, or nullptr if there isn't one
+     */
+    CanvasItem* itemAt(const QPoint& pos) const;
+
+    QSize sizeHint() const override;
+
+protected:
+    bool event(QEvent* event) override;
+    void paintEvent(QPaintEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+
+private:
+    std::vector<CanvasItem*> m_items;
+
+    // Graph items from m_items, which are redrawn by m_redrawTimer
+    std::vector<CanvasItem*> m_graphs;
+
+    int m_height = 0;
+
+    QTimer* m_redrawTimer;
+
+    // Stacks the items and returns true if any rectangle changed
+    bool relayout();
+};
@@ -0,0 +1,45 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#include "Graph.hpp"
+
+#include <QPainter>
+
+Graph::Graph(bool netUpdate, QWidget* parent)
+    : QWidget(parent), NetWidget(netUpdate) {
+    m_redrawTimer = new QTimer(this);
+    connect(m_redrawTimer, &QTimer::timeout, [this] {
+        if (m_plot.needsRedraw()) {
+            update();
+        }
+    });
+    m_redrawTimer->start(GraphPlot::kRedrawPeriod);
+}
+
+void Graph::setString(const std::wstring& text) {
+    m_plot.setTitle(text);
+    update();
+}
+
+std::wstring Graph::getString() const { return m_plot.getTitle(); }
+
+void Graph::setWindow(double seconds) { m_plot.setWindow(seconds); }
+
+void Graph::updateKeys(std::vector<std::string>& keys) {
+    NetWidget::updateKeys(keys);
+    m_plot.setKeys(keys);
+}
+
+void Graph::updateEntry() {
+    /* m_redrawTimer redraws when the histories receive samples, so there's
+     * nothing to do when the values change
+     */
+}
+
+QSize Graph::sizeHint() const { return QSize(200, 100); }
+
+void Graph::paintEvent(QPaintEvent* event) {
+    (void)event;
+
+    QPainter painter(this);
+    m_plot.paint(painter, rect());
+}
@@ -0,0 +1,50 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <QTimer>
+#include <QWidget>
+
+#include "GraphPlot.hpp"
+#include "NetWidget.hpp"
+
+/**
+ * Plots the recent values of one or more keys over a sliding time window
+ *
+ * Samples are recorded as packets arrive, but the plot is only redrawn at a
+ * fixed rate, and each redraw reduces the samples to one min/max pair per
+ * pixel column. This keeps high-rate signals from loading the GUI thread.
+ */
+class Graph : public QWidget, public NetWidget {
+    Q_OBJECT
+
+public:
+    explicit Graph(bool netUpdate, QWidget* parent = nullptr);
+
+    void setString(const std::wstring& text);
+    std::wstring getString() const;
+
+    /**
+     * Sets the length of the plotted time window in seconds
+     *
+     * Call before updateKeys() so the histories are sized for the window.
+     */
+    void setWindow(double seconds);
+
+    void updateKeys(std::vector<std::string>& keys) override;
+
+    void updateEntry() override;
+
+    QSize sizeHint() const override;
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+
+private:
+    GraphPlot m_plot;
+
+    QTimer* m_redrawTimer;
+};
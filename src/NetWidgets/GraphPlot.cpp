@@ -0,0 +1,153 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#include "GraphPlot.hpp"
+
+#include <cmath>
+
+#include <QPen>
+
+#include "NetWidget.hpp"
+
+namespace {
+const QColor kSeriesColors[] = {QColor(0, 160, 255), QColor(255, 140, 0),
+                                QColor(0, 200, 80), QColor(220, 50, 200),
+                                QColor(240, 220, 0)};
+}  // namespace
+
+GraphPlot::~GraphPlot() {
+    m_series.clear();
+    NetWidget::releaseHistories();
+}
+
+void GraphPlot::setTitle(const std::wstring& title) { m_title = title; }
+
+const std::wstring& GraphPlot::getTitle() const { return m_title; }
+
+void GraphPlot::setWindow(double seconds) {
+    if (std::isfinite(seconds) && seconds > 0.0) {
+        m_window = seconds;
+    }
+}
+
+void GraphPlot::setKeys(const std::vector<std::string>& keys) {
+    auto capacity = static_cast<size_t>(std::ceil(m_window * kMaxSampleRate));
+
+    m_series.clear();
+    for (const auto& key : keys) {
+        m_series.emplace_back(NetWidget::getHistory(key, capacity));
+    }
+    m_buckets.resize(m_series.size());
+
+    // New series are compared against zero, so existing samples are drawn
+    m_pushCounts.assign(m_series.size(), 0);
+
+    // Keys no longer plotted stop recording samples
+    NetWidget::releaseHistories();
+}
+
+bool GraphPlot::needsRedraw() {
+    bool redraw = m_plotted;
+    for (size_t i = 0; i < m_series.size(); i++) {
+        uint64_t pushCount = m_series[i]->pushCount();
+        if (pushCount != m_pushCounts[i]) {
+            m_pushCounts[i] = pushCount;
+            redraw = true;
+        }
+    }
+
+    return redraw;
+}
+
+void GraphPlot::paint(QPainter& painter, const QRect& rect) {
+    painter.save();
+    painter.translate(rect.left(), rect.top());
+    int width = rect.width();
+    int height = rect.height();
+
+    painter.fillRect(QRect(0, 0, width, height), QColor(30, 30, 30));
+
+    int titleHeight = painter.fontMetrics().height();
+    painter.setPen(QColor(220, 220, 220));
+    painter.drawText(2, painter.fontMetrics().ascent(),
+                     QString::fromStdWString(m_title));
+
+    QRect plot(0, titleHeight, width, height - titleHeight);
+    if (plot.width() <= 0 || plot.height() <= 0) {
+        painter.restore();
+        return;
+    }
+
+    // Decimate every series first so they can share one vertical scale
+    double end = NetWidget::getSampleTime();
+    double start = end - m_window;
+    double minValue = INFINITY;
+    double maxValue = -INFINITY;
+    for (size_t i = 0; i < m_series.size(); i++) {
+        auto& buckets = m_buckets[i];
+        buckets.resize(plot.width());
+        m_series[i]->decimate(start, end, buckets);
+
+        for (const auto& bucket : buckets) {
+            if (bucket.count > 0) {
+                minValue = std::fmin(minValue, bucket.min);
+                maxValue = std::fmax(maxValue, bucket.max);
+            }
+        }
+    }
+
+    m_plotted = minValue <= maxValue;
+    if (!m_plotted) {
+        painter.restore();
+        return;
+    }
+    if (minValue == maxValue) {
+        minValue -= 1.0;
+        maxValue += 1.0;
+    }
+
+    double scale = (plot.height() - 1) / (maxValue - minValue);
+    auto toY = [&](double value) {
+        return plot.bottom() - static_cast<int>((value - minValue) * scale);
+    };
+
+    for (size_t i = 0; i < m_series.size(); i++) {
+        painter.setPen(kSeriesColors[i % (sizeof(kSeriesColors) /
+                                          sizeof(kSeriesColors[0]))]);
+
+        /* Each column is a vertical line spanning its min and max. Values
+         * hold until the next sample, so the previous nonempty column's last
+         * sample is drawn level up to the column, then steps to its first.
+         */
+        int prevX = -1;
+        int prevY = 0;
+        const auto& buckets = m_buckets[i];
+        for (int x = 0; x < static_cast<int>(buckets.size()); x++) {
+            const auto& bucket = buckets[x];
+            if (bucket.count == 0) {
+                continue;
+            }
+
+            if (prevX >= 0) {
+                painter.drawLine(prevX, prevY, x, prevY);
+                painter.drawLine(x, prevY, x, toY(bucket.first));
+            }
+            painter.drawLine(x, toY(bucket.min), x, toY(bucket.max));
+
+            prevX = x;
+            prevY = toY(bucket.last);
+        }
+
+        // The last value still holds at the right edge, which is the present
+        if (prevX >= 0) {
+            painter.drawLine(prevX, prevY, plot.width() - 1, prevY);
+        }
+    }
+
+    painter.setPen(QColor(160, 160, 160));
+    painter.drawText(plot.right() - 60, plot.top() + titleHeight,
+                     QString::number(maxValue, 'g', 4));
+    painter.drawText(plot.right() - 60, plot.bottom() - 2,
+                     QString::number(minValue, 'g', 4));
+
+    painter.restore();
+}
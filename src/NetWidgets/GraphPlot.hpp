@@ -0,0 +1,75 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <QPainter>
+#include <QRect>
+
+#include "TimeSeries.hpp"
+
+/**
+ * Draws the recent values of one or more keys over a sliding time window
+ *
+ * This holds the state shared by the Graph widget and graphs drawn by a
+ * ColumnCanvas. Each redraw reduces the samples to one min/max pair per pixel
+ * column, so the cost of drawing doesn't depend on the sample rate.
+ */
+class GraphPlot {
+public:
+    // Highest sample rate the histories are sized for in Hz
+    static constexpr double kMaxSampleRate = 250.0;
+
+    // Time between redraws in milliseconds
+    static constexpr int kRedrawPeriod = 33;
+
+    // Releases the histories which no other plot uses
+    ~GraphPlot();
+
+    void setTitle(const std::wstring& title);
+    const std::wstring& getTitle() const;
+
+    /**
+     * Sets the length of the plotted time window in seconds
+     *
+     * Call before setKeys() so the histories are sized for the window.
+     */
+    void setWindow(double seconds);
+
+    /**
+     * Plots the histories of the given keys
+     */
+    void setKeys(const std::vector<std::string>& keys);
+
+    /**
+     * Returns true if the plot should be redrawn, which is the case if samples
+     * arrived or if the last redraw plotted samples which now have to scroll
+     *
+     * Arrivals are detected from the histories themselves, so a run of equal
+     * samples, which doesn't change the key's value, still scrolls in.
+     */
+    bool needsRedraw();
+
+    /**
+     * Draws the title and plot into the rectangle
+     */
+    void paint(QPainter& painter, const QRect& rect);
+
+private:
+    std::wstring m_title;
+    double m_window = 10.0;
+
+    std::vector<std::shared_ptr<TimeSeries>> m_series;
+
+    // One bucket per pixel column per series, reused between redraws
+    std::vector<std::vector<TimeSeries::Bucket>> m_buckets;
+
+    // Push count of each series when needsRedraw() last checked it
+    std::vector<uint64_t> m_pushCounts;
+
+    // True if the last redraw plotted any samples
+    bool m_plotted = false;
+};
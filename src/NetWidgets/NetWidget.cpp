@@ -2,107 +2,540 @@
 
 #include "NetWidget.hpp"
 
-#include <algorithm>
-#include <codecvt>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
-#include <locale>
 #include <sstream>
 #include <type_traits>
 #include <utility>
 
+#include "../Telemetry/Recorder.hpp"
 #include "../Util.hpp"
+#include "DSDisplay/Protocol.hpp"
 
 std::vector<NetWidget*> NetWidget::m_netObjs;
-std::map<std::string, NetWidget::NetEntry> NetWidget::m_netValues;
+std::vector<NetWidget::Slot> NetWidget::m_slots;
+std::unordered_map<std::string, uint32_t> NetWidget::m_slotIndices;
+std::string NetWidget::m_keyBuffer;
+std::vector<uint32_t> NetWidget::m_keyIdTable;
+std::vector<std::string> NetWidget::m_keyNames;
+std::vector<NetWidget::RecordField> NetWidget::m_recordFields;
+uint64_t NetWidget::m_generation = 0;
+
+namespace {
+/* Decodes UTF-8 onto the end of buffer without a temporary QString, so only
+ * growing the buffer allocates
+ */
+void appendUtf8(QString& buffer, std::string_view value) {
+    int size = buffer.size();
+    buffer.resize(size + static_cast<int>(value.size()));
+    auto dest = reinterpret_cast<char16_t*>(buffer.data()) + size;
+    buffer.resize(size + static_cast<int>(decodeUtf8(value, dest)));
+}
+}  // namespace
 
 NetWidget::NetWidget(bool trackUpdate) : m_trackUpdate(trackUpdate) {
     if (m_trackUpdate) {
+        m_netIndex = m_netObjs.size();
         m_netObjs.push_back(this);
     }
 }
 
 NetWidget::~NetWidget() {
     if (m_trackUpdate) {
-        auto index = std::find(m_netObjs.begin(), m_netObjs.end(), this);
+        /* Moving the last object into this one's place keeps removal
+         * constant time. The order elements update in doesn't matter.
+         */
+        m_netObjs[m_netIndex] = m_netObjs.back();
+        m_netObjs[m_netIndex]->m_netIndex = m_netIndex;
+        m_netObjs.pop_back();
+    }
+}
+
+void NetWidget::setUpdateText(const std::wstring& text) {
+    m_updateText = text;
+    m_needsUpdate = true;
+
+    m_segments.clear();
+
+    // Extends the previous segment if it's also a literal
+    auto addLiteral = [this](size_t start, size_t end) {
+        if (end == start) {
+            return;
+        }
+
+        if (m_segments.empty() || !m_segments.back().spec.empty()) {
+            m_segments.emplace_back();
+        }
+        m_segments.back().literal += QString::fromStdWString(
+            m_updateText.substr(start, end - start));
+    };
 
-        if (index != m_netObjs.end()) {
-            m_netObjs.erase(index);
+    size_t pos = 0;
+    while (pos < m_updateText.length()) {
+        size_t percent = m_updateText.find(L'%', pos);
+        if (percent == std::wstring::npos) {
+            addLiteral(pos, m_updateText.length());
+            break;
+        }
+        addLiteral(pos, percent);
+
+        // "%%" is a literal '%', so the second one is skipped
+        if (percent + 1 < m_updateText.length() &&
+            m_updateText[percent + 1] == L'%') {
+            addLiteral(percent, percent + 1);
+            pos = percent + 2;
+            continue;
+        }
+
+        /* A % which doesn't start a spec is part of the literal. So is one
+         * whose spec is too wide, which LayoutParser reports.
+         */
+        FormatSpec spec;
+        if (!scanFormatSpec(m_updateText, percent, spec) || !spec.supported) {
+            addLiteral(percent, percent + 1);
+            pos = percent + 1;
+        } else {
+            // Specs only contain ASCII, so they narrow losslessly
+            m_segments.emplace_back();
+            auto& segment = m_segments.back();
+            segment.spec.assign(m_updateText.begin() + percent,
+                                m_updateText.begin() + spec.end);
+            segment.width = spec.width;
+            segment.precision = spec.precision;
+            segment.leftAlign = spec.leftAlign;
+            pos = spec.end;
         }
     }
+}
+
+const std::wstring& NetWidget::getUpdateText() { return m_updateText; }
 
-    if (m_netObjs.size() == 0) {
-        m_netValues.clear();
+void NetWidget::updateValues(PacketReader& reader, uint8_t version,
+                             Recorder* recorder) {
+    // Every value in a packet shares the packet's arrival time
+    double time = getSampleTime();
+
+    if (recorder != nullptr) {
+        recorder->beginPacket();
+    }
+
+    while (!reader.atEnd()) {
+        auto type = reader.read<uint8_t>();
+
+        Slot* entry = nullptr;
+        const std::string* name = nullptr;
+
+        if (version >= Protocol::kVersion2) {
+            auto id = reader.read<uint16_t>();
+            if (!reader.ok()) {
+                break;
+            }
+
+            // Values for unknown IDs are still read to reach the next entry
+            if (id < m_keyIdTable.size()) {
+                entry = &m_slots[m_keyIdTable[id]];
+                name = &m_keyNames[id];
+            }
+        } else {
+            m_keyBuffer.assign(reader.readString());
+            if (!reader.ok()) {
+                break;
+            }
+
+            auto slot = m_slotIndices.find(m_keyBuffer);
+            if (slot != m_slotIndices.end()) {
+                entry = &m_slots[slot->second];
+            }
+            name = &m_keyBuffer;
+        }
+
+        size_t valuePos = reader.position();
+
+        // The size of an unknown value can't be skipped
+        if (!readValue(reader, static_cast<Protocol::ValueType>(type), entry,
+                       time)) {
+            return;
+        }
+
+        if (recorder != nullptr && name != nullptr && reader.ok()) {
+            recorder->addValue(*name, static_cast<Protocol::ValueType>(type),
+                               reader.data() + valuePos,
+                               reader.position() - valuePos);
+        }
     }
 }
 
-void NetWidget::setUpdateText(const std::wstring& text) { m_updateText = text; }
+bool NetWidget::readValue(PacketReader& reader, Protocol::ValueType type,
+                          Slot* entry, double time) {
+    switch (type) {
+        case Protocol::ValueType::Char: {
+            auto value = reader.read<uint8_t>();
 
-const std::wstring& NetWidget::getUpdateText() { return m_updateText; }
+            if (entry != nullptr && reader.ok()) {
+                if (entry->history != nullptr) {
+                    entry->history->push(time, value);
+                }
+                storeValue(*entry, value);
+            }
+            break;
+        }
+        case Protocol::ValueType::Int32: {
+            auto value = reader.read<int32_t>();
+
+            if (entry != nullptr && reader.ok()) {
+                if (entry->history != nullptr) {
+                    entry->history->push(time, value);
+                }
+                storeValue(*entry, value);
+            }
+            break;
+        }
+        case Protocol::ValueType::String: {
+            auto value = reader.readString();
+
+            if (entry != nullptr && reader.ok()) {
+                // Strings stay UTF-8 until they're displayed
+                storeString(*entry, value);
+
+                /* Version 1 robots send doubles as strings, so plot
+                 * numeric strings. The stored copy is null-terminated.
+                 */
+                if (entry->history != nullptr) {
+                    const char* text =
+                        std::get<std::string>(entry->value).c_str();
+                    char* end;
+                    double number = std::strtod(text, &end);
+                    if (end != text) {
+                        entry->history->push(time, number);
+                    }
+                }
+            }
+            break;
+        }
+        case Protocol::ValueType::Double: {
+            auto bits = reader.read<uint64_t>();
 
-void NetWidget::updateValues(std::vector<char>& data, size_t& pos) {
-    uint8_t type;
-    std::string key;
+            if (entry != nullptr && reader.ok()) {
+                double value;
+                std::memcpy(&value, &bits, sizeof(value));
 
-    while (pos < data.size() && packetToVar(data, pos, type) &&
-           packetToVar(data, pos, key)) {
-        auto& entry = m_netValues[key];
+                if (entry->history != nullptr) {
+                    entry->history->push(time, value);
+                }
+                storeValue(*entry, value);
+            }
+            break;
+        }
+        default:
+            return false;
+    }
 
-        // Assign value to prepared space
-        if (type == 'c') {
-            uint8_t value = 0;
-            packetToVar(data, pos, value);
+    return true;
+}
 
-            entry = value;
-        } else if (type == 'i') {
-            int32_t value = 0;
-            packetToVar(data, pos, value);
+void NetWidget::updateRecord(PacketReader& reader, Recorder* recorder) {
+    double time = getSampleTime();
 
-            entry = value;
-        } else if (type == 's') {
-            std::string value;
-            packetToVar(data, pos, value);
+    if (recorder != nullptr) {
+        recorder->beginPacket();
+    }
+
+    // Fields are decoded in place at the offsets the robot sent
+    const char* record = reader.data() + reader.position();
+    size_t recordSize = reader.remaining();
+
+    for (const auto& field : m_recordFields) {
+        if (field.offset + field.size > recordSize ||
+            field.keyId >= m_keyIdTable.size()) {
+            continue;
+        }
 
-            std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
-            entry = converter.from_bytes(value);
+        PacketReader fieldReader(record, field.offset + field.size,
+                                 field.offset);
+        if (!readValue(fieldReader, field.type,
+                       &m_slots[m_keyIdTable[field.keyId]], time) ||
+            !fieldReader.ok()) {
+            continue;
+        }
+
+        if (recorder != nullptr) {
+            recorder->addValue(m_keyNames[field.keyId], field.type,
+                               record + field.offset,
+                               fieldReader.position() - field.offset);
         }
     }
 }
 
+void NetWidget::setRecordFields(std::vector<RecordField> fields) {
+    m_recordFields = std::move(fields);
+}
+
+void NetWidget::setKeyIds(const std::vector<std::string>& keys) {
+    m_keyIdTable.clear();
+    m_keyIdTable.reserve(keys.size());
+    m_keyNames = keys;
+
+    for (const auto& key : keys) {
+        m_keyIdTable.push_back(internKey(key));
+    }
+}
+
+uint32_t NetWidget::internKey(const std::string& key) {
+    auto result = m_slotIndices.emplace(key, m_slots.size());
+    if (result.second) {
+        m_slots.emplace_back();
+    }
+
+    return result.first->second;
+}
+
+void NetWidget::clearValues() {
+    m_keyIdTable.clear();
+    m_keyNames.clear();
+    m_recordFields.clear();
+    m_slotIndices.clear();
+    m_slots.clear();
+}
+
 NetWidget::NetEntry& NetWidget::getEntry(const std::string& key) {
-    // If there is a value for the given key, return it
-    return m_netValues[key];
+    return m_slots[internKey(key)].value;
+}
+
+void NetWidget::setEntry(const std::string& key, NetEntry value) {
+    storeValue(m_slots[internKey(key)], std::move(value));
+}
+
+std::shared_ptr<TimeSeries> NetWidget::getHistory(const std::string& key,
+                                                  size_t capacity) {
+    auto& history = m_slots[internKey(key)].history;
+    if (history == nullptr) {
+        history = std::make_shared<TimeSeries>(capacity);
+    } else {
+        history->reserve(capacity);
+    }
+
+    return history;
+}
+
+void NetWidget::releaseHistories() {
+    for (auto& slot : m_slots) {
+        // The slot holds the only reference left
+        if (slot.history.use_count() == 1) {
+            slot.history.reset();
+        }
+    }
+}
+
+double NetWidget::getSampleTime() {
+    using namespace std::chrono;
+
+    static const auto startTime = steady_clock::now();
+    return duration<double>(steady_clock::now() - startTime).count();
 }
 
 void NetWidget::updateElements() {
     for (auto i : m_netObjs) {
-        i->updateEntry();
+        if (i->m_active && i->isStale()) {
+            i->updateEntry();
+            i->m_updatedGeneration = m_generation;
+            i->m_needsUpdate = false;
+        }
     }
 }
 
-void NetWidget::updateKeys(std::vector<std::string>& keys) { m_varIds = keys; }
+void NetWidget::updateKeys(std::vector<std::string>& keys) {
+    m_varIds = keys;
+    m_needsUpdate = true;
 
-std::wstring NetWidget::fillEntry(NetEntry& entry) {
-    std::wstring replacement;
+    m_varSlots.clear();
+    for (const auto& key : keys) {
+        m_varSlots.push_back(internKey(key));
+    }
+}
 
-    std::visit(
-        [&](auto&& arg) {
-            using T = std::decay_t<decltype(arg)>;
+void NetWidget::setActive(bool active) { m_active = active; }
 
-            if constexpr (std::is_same_v<T, int32_t>) {
-                replacement = std::to_wstring(std::get<int32_t>(entry));
-            } else {
-                // Else data is already in a string
-                replacement = std::get<std::wstring>(entry);
-            }
-        },
-        entry);
+const QString& NetWidget::fillEntry(const NetEntry& entry) {
+    /* truncate() keeps the capacity, so this only allocates while it grows.
+     * clear() would free it.
+     */
+    m_textBuffer.truncate(0);
 
-    std::wstring buffer = m_updateText;
-    size_t pos = 0;
+    for (const auto& segment : m_segments) {
+        if (segment.spec.empty()) {
+            m_textBuffer += segment.literal;
+        } else {
+            appendEntry(m_textBuffer, entry, segment);
+        }
+    }
 
-    while ((pos = buffer.find(L"%s", pos)) != std::wstring::npos) {
-        buffer.replace(pos, 2, replacement);
+    return m_textBuffer;
+}
+
+void NetWidget::fillRuns(const NetEntry& entry, std::vector<QString>& runs) {
+    runs.resize(m_segments.size());
+
+    for (size_t i = 0; i < m_segments.size(); i++) {
+        const auto& segment = m_segments[i];
+
+        // Literal runs share the segment's text instead of copying it
+        if (segment.spec.empty()) {
+            runs[i] = segment.literal;
+        } else {
+            runs[i].truncate(0);
+            appendEntry(runs[i], entry, segment);
+        }
+    }
+}
+
+bool NetWidget::isValueRun(size_t index) const {
+    return index < m_segments.size() && !m_segments[index].spec.empty();
+}
+
+int NetWidget::getFieldWidth(size_t index) const {
+    if (!isValueRun(index)) {
+        return 0;
     }
 
-    return buffer;
+    return m_segments[index].width;
+}
+
+const NetWidget::NetEntry& NetWidget::getVarEntry(size_t index) const {
+    static const NetEntry empty;
+
+    if (index >= m_varSlots.size()) {
+        return empty;
+    }
+    return m_slots[m_varSlots[index]].value;
+}
+
+bool NetWidget::hasVarEntry(size_t index) const {
+    return index < m_varSlots.size() &&
+           m_slots[m_varSlots[index]].generation != 0;
+}
+
+bool NetWidget::isStale() const {
+    if (m_needsUpdate) {
+        return true;
+    }
+
+    for (auto slot : m_varSlots) {
+        if (m_slots[slot].generation > m_updatedGeneration) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void NetWidget::storeValue(Slot& slot, NetEntry&& value) {
+    if (slot.generation == 0 || slot.value != value) {
+        slot.value = std::move(value);
+        slot.generation = ++m_generation;
+    }
+}
+
+void NetWidget::storeString(Slot& slot, std::string_view value) {
+    auto current = std::get_if<std::string>(&slot.value);
+    if (current == nullptr) {
+        storeValue(slot, std::string(value));
+    } else if (*current != value) {
+        // assign() only allocates if the new string is longer
+        current->assign(value);
+        slot.generation = ++m_generation;
+    }
+}
+
+int32_t NetWidget::toInt(const NetEntry& entry) {
+    if (auto value = std::get_if<int32_t>(&entry)) {
+        return *value;
+    } else if (auto value = std::get_if<double>(&entry)) {
+        // Out of range values would be undefined behavior to convert
+        if (!(std::fabs(*value) < INT32_MAX)) {
+            return 0;
+        }
+        return static_cast<int32_t>(std::lround(*value));
+    } else {
+        return std::strtol(std::get<std::string>(entry).c_str(), nullptr, 10);
+    }
+}
+
+double NetWidget::toDouble(const NetEntry& entry) {
+    if (auto value = std::get_if<int32_t>(&entry)) {
+        return *value;
+    } else if (auto value = std::get_if<double>(&entry)) {
+        return *value;
+    } else {
+        const char* str = std::get<std::string>(entry).c_str();
+        char* end;
+        double number = std::strtod(str, &end);
+        return end != str ? number : NAN;
+    }
+}
+
+void NetWidget::appendEntry(QString& buffer, const NetEntry& entry,
+                            const Segment& segment) {
+    const auto& spec = segment.spec;
+    char conversion = spec.back();
+    int start = buffer.size();
+
+    // Large enough for %f of any double
+    char result[512];
+    int length = 0;
+
+    if (conversion == 's') {
+        /* Values are formatted like std::to_string(), which is how the robot
+         * used to format them itself. Like printf(), the precision limits how
+         * many characters are shown.
+         */
+        if (auto value = std::get_if<std::string>(&entry)) {
+            appendUtf8(buffer, *value);
+        } else if (auto value = std::get_if<double>(&entry)) {
+            length = std::snprintf(result, sizeof(result), "%f", *value);
+        } else {
+            length = std::snprintf(result, sizeof(result), "%d",
+                                   std::get<int32_t>(entry));
+        }
+    } else {
+        double number = toDouble(entry);
+
+        // Strings which aren't numbers are shown unformatted
+        if (std::isnan(number) &&
+            std::holds_alternative<std::string>(entry)) {
+            appendUtf8(buffer, std::get<std::string>(entry));
+        } else if (std::strchr("dixX", conversion) != nullptr) {
+            length = std::snprintf(result, sizeof(result), spec.c_str(),
+                                   toInt(entry));
+        } else {
+            length = std::snprintf(result, sizeof(result), spec.c_str(),
+                                   number);
+        }
+    }
+
+    // Formatted numbers are ASCII
+    if (length > 0) {
+        buffer += QLatin1String(result, length);
+    }
+
+    if (conversion == 's' && segment.precision >= 0 &&
+        buffer.size() - start > segment.precision) {
+        buffer.truncate(start + segment.precision);
+    }
+
+    // snprintf() already padded numbers formatted with the spec
+    int padding = segment.width - (buffer.size() - start);
+    if (padding > 0) {
+        // Widths have at most kMaxFormatDigits digits
+        static const QString spaces(99, QLatin1Char(' '));
+
+        if (segment.leftAlign) {
+            buffer.append(spaces.constData(), padding);
+        } else {
+            buffer.insert(start, spaces.constData(), padding);
+        }
+    }
 }
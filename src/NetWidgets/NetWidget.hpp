@@ -5,11 +5,21 @@
 #include <stdint.h>
 
 #include <cstdlib>  // For std::memcpy(3)
-#include <map>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <variant>
 #include <vector>
 
+#include <QString>
+
+#include "../PacketReader.hpp"
+#include "DSDisplay/Protocol.hpp"
+#include "TimeSeries.hpp"
+
+class Recorder;
+
 /**
  * Allows drawable objects to update over the network
  *
@@ -22,7 +32,8 @@
  */
 class NetWidget {
 public:
-    using NetEntry = std::variant<int32_t, std::wstring>;
+    // Strings are stored as received, in UTF-8
+    using NetEntry = std::variant<int32_t, double, std::string>;
 
     /**
      * Passing 'true' adds the object to m_updateObjs, which makes it update
@@ -34,6 +45,9 @@ public:
 
     /**
      * Sets string which determines how displayed text is updated
+     *
+     * The text is split into literal and placeholder segments here once
+     * instead of being searched for placeholders on every update.
      */
     void setUpdateText(const std::wstring& text);
 
@@ -43,9 +57,59 @@ public:
     const std::wstring& getUpdateText();
 
     /**
-     * Updates values currently in table and adds new ones if they don't exist
+     * Updates values currently in table from the rest of the packet
+     *
+     * Version 2 packets refer to keys by the IDs assigned with setKeyIds()
+     * instead of by name. If a recorder is given, every value read is also
+     * recorded with it.
+     */
+    static void updateValues(PacketReader& reader, uint8_t version,
+                             Recorder* recorder = nullptr);
+
+    // Location of a key's value in a version 4 record
+    struct RecordField {
+        uint16_t keyId = 0;
+        Protocol::ValueType type = Protocol::ValueType::Char;
+        uint16_t offset = 0;
+        uint16_t size = 0;
+    };
+
+    /**
+     * Updates values from a version 4 record, which holds each value at the
+     * offset given to setRecordFields()
+     */
+    static void updateRecord(PacketReader& reader,
+                             Recorder* recorder = nullptr);
+
+    /**
+     * Sets the record layout sent by the robot along with guiCreate
      */
-    static void updateValues(std::vector<char>& data, size_t& pos);
+    static void setRecordFields(std::vector<RecordField> fields);
+
+    /**
+     * Assigns each key an ID equal to its index, as sent by the robot along
+     * with guiCreate
+     */
+    static void setKeyIds(const std::vector<std::string>& keys);
+
+    /**
+     * Returns the index of a key's slot in the value table, creating the slot
+     * if the key doesn't have one yet
+     *
+     * Keys are interned while the GUI is built, so receiving values never
+     * allocates and only version 1 packets need to look keys up by name.
+     * Values for keys which were never interned are dropped.
+     */
+    static uint32_t internKey(const std::string& key);
+
+    /**
+     * Drops every slot along with the key IDs and record fields which refer
+     * to them
+     *
+     * The window calls this when the layout's keys change. Elements must then
+     * look their keys up again with updateKeys().
+     */
+    static void clearValues();
 
     /**
      * Returns the corresponding network value of a keyword
@@ -53,19 +117,101 @@ public:
     static NetEntry& getEntry(const std::string& key);
 
     /**
-     * All elements' values are updated from the table of network values
+     * Stores a value for a keyword as if it was received, so elements using
+     * it update
+     */
+    static void setEntry(const std::string& key, NetEntry value);
+
+    /**
+     * Returns the history of a key's numeric values, creating it if necessary
+     *
+     * Once a key has a history, every value received for it is recorded with
+     * the time it arrived, until releaseHistories() finds it unused. The
+     * history holds at least the given number of samples.
+     */
+    static std::shared_ptr<TimeSeries> getHistory(const std::string& key,
+                                                  size_t capacity);
+
+    /**
+     * Stops recording the histories nothing holds a reference to anymore
+     *
+     * Call after dropping histories returned by getHistory().
+     */
+    static void releaseHistories();
+
+    /**
+     * Returns the current time on the clock used to timestamp history samples
+     * in seconds
+     */
+    static double getSampleTime();
+
+    /**
+     * Elements whose values changed since they last updated are updated from
+     * the table of network values
      */
     static void updateElements();
 
     /**
      * Updates keys which are used to retrieve the network variables
+     *
+     * The element is updated by the next call to updateElements() regardless
+     * of whether its values changed.
      */
     virtual void updateKeys(std::vector<std::string>& keys);
 
+    /**
+     * Sets whether updateElements() updates the element
+     *
+     * Values for an inactive element's keys are still stored, so it catches
+     * up on the next call to updateElements() after it's made active again.
+     * Elements which update through a child NetWidget forward this to it.
+     */
+    virtual void setActive(bool active);
+
     /**
      * Insert value into update text and return the result
+     *
+     * %s inserts the value as is. printf-style specs such as %.2f, %5d, or %x
+     * format numbers, converting the value if necessary. %% inserts a single
+     * %, and a % which doesn't start a spec is kept as is.
+     *
+     * Strings are converted from UTF-8 straight into the result. The result is
+     * written into a buffer reused by every call, so it's only valid until
+     * the next call.
+     */
+    const QString& fillEntry(const NetEntry& entry);
+
+    /**
+     * Formats the update text like fillEntry(), but into one string per run
+     * of the compiled update text
+     *
+     * Literal runs never change, so comparing runs tells which parts of the
+     * text changed.
      */
-    std::wstring fillEntry(NetEntry& entry);
+    void fillRuns(const NetEntry& entry, std::vector<QString>& runs);
+
+    // Returns true if the run of fillRuns() at the index holds the value
+    bool isValueRun(size_t index) const;
+
+    /**
+     * Returns the minimum number of characters the format spec of a value run
+     * produces, such as 5 for %5d, or 0 if it has no width
+     */
+    int getFieldWidth(size_t index) const;
+
+    /**
+     * Returns the value as an integer, rounding doubles and parsing strings
+     *
+     * Returns 0 for strings which don't start with a number.
+     */
+    static int32_t toInt(const NetEntry& entry);
+
+    /**
+     * Returns the value as a double, parsing strings
+     *
+     * Returns NaN for strings which don't start with a number.
+     */
+    static double toDouble(const NetEntry& entry);
 
     /**
      * Updates custom values of object to display
@@ -75,11 +221,111 @@ public:
 protected:
     std::vector<std::string> m_varIds;
 
+    // Slot indices of the keys in m_varIds
+    std::vector<uint32_t> m_varSlots;
+
+    /**
+     * Returns the value of the key at the given index of m_varIds, or an empty
+     * entry if the element wasn't given that many keys
+     */
+    const NetEntry& getVarEntry(size_t index) const;
+
+    /**
+     * Returns true once a value was received for the key at the given index
+     * of m_varIds
+     *
+     * Until then, getVarEntry() returns 0, which shouldn't be shown.
+     */
+    bool hasVarEntry(size_t index) const;
+
 private:
+    // Returns true if any of the element's values changed since it updated
+    bool isStale() const;
+
+    /* Piece of the compiled update text. Literal segments hold their text and
+     * placeholder segments hold their format spec, which is always ASCII.
+     */
+    struct Segment {
+        QString literal;
+        std::string spec;
+
+        // Field width, precision, and alignment parsed from the spec
+        int width = 0;
+        int precision = -1;
+        bool leftAlign = false;
+    };
+
+    /* Appends a value formatted with the spec of a placeholder segment, padded
+     * to the spec's width
+     */
+    static void appendEntry(QString& buffer, const NetEntry& entry,
+                            const Segment& segment);
+
+    struct Slot {
+        NetEntry value;
+
+        /* Value of m_generation when the value last changed, or 0 if no
+         * value was received yet
+         */
+        uint64_t generation = 0;
+
+        // Only allocated for keys something plots
+        std::shared_ptr<TimeSeries> history;
+    };
+
+    /* Reads a value of the given type and stores it in the entry if there is
+     * one. Returns false if the type is unknown.
+     */
+    static bool readValue(PacketReader& reader, Protocol::ValueType type,
+                          Slot* entry, double time);
+
+    /* Stores a received value, advancing the slot's generation if it
+     * changed or is the first one. Histories are redrawn when samples are
+     * pushed to them, so repeated values don't update elements.
+     */
+    static void storeValue(Slot& slot, NetEntry&& value);
+
+    /* Stores a received string, reusing the slot's string if it already holds
+     * one
+     */
+    static void storeString(Slot& slot, std::string_view value);
+
     static std::vector<NetWidget*> m_netObjs;
-    static std::map<std::string, NetEntry> m_netValues;
+
+    // Incremented each time any slot's value changes
+    static uint64_t m_generation;
+
+    // Values of every interned key, stored contiguously
+    static std::vector<Slot> m_slots;
+    static std::unordered_map<std::string, uint32_t> m_slotIndices;
+
+    // Version 1 key names are copied here to look them up in m_slotIndices
+    static std::string m_keyBuffer;
+
+    // Slot indices and names of keys indexed by key ID
+    static std::vector<uint32_t> m_keyIdTable;
+    static std::vector<std::string> m_keyNames;
+
+    // Fields of version 4 records
+    static std::vector<RecordField> m_recordFields;
 
     std::wstring m_updateText;
+    std::vector<Segment> m_segments;
+
+    // Holds the result of fillEntry() so its capacity is reused
+    QString m_textBuffer;
+
+    // Value of m_generation when the element last updated
+    uint64_t m_updatedGeneration = 0;
+
+    // Set when the element has to update even if its values didn't change
+    bool m_needsUpdate = true;
+
+    // Cleared while the element is on a hidden page
+    bool m_active = true;
 
     const bool m_trackUpdate;
+
+    // Index of this object in m_netObjs if it's tracked
+    size_t m_netIndex = 0;
 };
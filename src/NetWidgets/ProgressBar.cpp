@@ -2,8 +2,6 @@
 
 #include "ProgressBar.hpp"
 
-#include <type_traits>
-
 ProgressBar::ProgressBar(bool netUpdate, QWidget* parent)
     : QWidget(parent), NetWidget(netUpdate) {
     QVBoxLayout* layout = new QVBoxLayout(this);
@@ -35,25 +33,11 @@ void ProgressBar::setString(const std::wstring& text) {
     m_text->setString(text);
 }
 
+void ProgressBar::setString(const QString& text) { m_text->setString(text); }
+
 std::wstring ProgressBar::getString() { return m_text->getString(); }
 
 void ProgressBar::updateEntry() {
-    NetEntry& printEntry = getEntry(m_varIds[0]);
-    setString(NetWidget::fillEntry(printEntry));
-
-    NetEntry& percentEntry = getEntry(m_varIds[1]);
-
-    std::visit(
-        [&](auto&& arg) {
-            int32_t value;
-            using T = std::decay_t<decltype(arg)>;
-
-            if constexpr (std::is_same_v<T, int32_t>) {
-                value = std::get<int32_t>(percentEntry);
-            } else {
-                value = std::stoi(std::get<std::wstring>(percentEntry));
-            }
-            setPercent(value);
-        },
-        percentEntry);
+    setString(NetWidget::fillEntry(getVarEntry(0)));
+    setPercent(toInt(getVarEntry(1)));
 }
@@ -23,6 +23,7 @@ public:
     int getPercent();
 
     void setString(const std::wstring& text);
+    void setString(const QString& text);
     std::wstring getString();
 
     void updateEntry() override;
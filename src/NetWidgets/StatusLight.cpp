@@ -30,4 +30,9 @@ void StatusLight::updateKeys(std::vector<std::string>& keys) {
     m_circle->updateKeys(keys);
 }
 
+void StatusLight::setActive(bool active) {
+    NetWidget::setActive(active);
+    m_circle->setActive(active);
+}
+
 void StatusLight::updateEntry() { setString(getUpdateText()); }
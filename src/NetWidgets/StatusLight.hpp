@@ -28,6 +28,9 @@ public:
 
     void updateKeys(std::vector<std::string>& keys);
 
+    // The circle is the part which updates, so it's what becomes inactive
+    void setActive(bool active) override;
+
     void updateEntry() override;
 
 private:
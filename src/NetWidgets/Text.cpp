@@ -2,26 +2,125 @@
 
 #include "Text.hpp"
 
+#include <algorithm>
+
+#include <QPaintEvent>
+#include <QPainter>
+#include <QTransform>
+
 Text::Text(bool netUpdate, QWidget* parent)
-    : QLabel(parent), NetWidget(netUpdate) {}
+    : QWidget(parent), NetWidget(netUpdate) {}
 
 void Text::setString(const std::wstring& text) {
-    setText(QString::fromStdWString(text));
-    update();
+    setString(QString::fromStdWString(text));
 }
 
-std::wstring Text::getString() const { return text().toStdWString(); }
+void Text::setString(const QString& text) {
+    m_runs.resize(1);
+    m_runs[0].text = text;
+    m_runs[0].width = prepareRun(m_runs[0]);
+    m_showingValues = false;
+
+    layoutRuns();
+}
+
+std::wstring Text::getString() const {
+    QString text;
+    for (const auto& run : m_runs) {
+        text += run.text;
+    }
+    return text.toStdWString();
+}
 
 void Text::updateEntry() {
-    NetEntry& printEntry = getEntry(m_varIds[0]);
+    // The start text stays until the first value arrives
+    if (!hasVarEntry(0)) {
+        return;
+    }
+
+    fillRuns(getVarEntry(0), m_runTexts);
+
+    // The runs are recreated if the update text changed
+    if (!m_showingValues || getUpdateText() != m_runTemplate) {
+        m_runTemplate = getUpdateText();
+        m_showingValues = true;
+
+        int digitWidth = fontMetrics().horizontalAdvance(QChar('0'));
+        m_runs.resize(m_runTexts.size());
+        for (size_t i = 0; i < m_runs.size(); i++) {
+            m_runs[i].text = m_runTexts[i];
+            m_runs[i].width = std::max(prepareRun(m_runs[i]),
+                                       getFieldWidth(i) * digitWidth);
+        }
+
+        layoutRuns();
+        return;
+    }
+
+    bool grew = false;
+    for (size_t i = 0; i < m_runs.size(); i++) {
+        auto& run = m_runs[i];
+        if (run.text == m_runTexts[i]) {
+            continue;
+        }
+
+        run.text = m_runTexts[i];
+        int width = prepareRun(run);
+        if (width > run.width) {
+            run.width = width;
+            grew = true;
+        } else {
+            update(run.x, 0, run.width, height());
+        }
+    }
 
-    std::visit(
-        [&](auto&& arg) {
-            using T = std::decay_t<decltype(arg)>;
+    if (grew) {
+        layoutRuns();
+    }
+}
+
+QSize Text::sizeHint() const {
+    return QSize(m_width, fontMetrics().height());
+}
+
+QSize Text::minimumSizeHint() const { return sizeHint(); }
 
-            if constexpr (std::is_same_v<T, std::wstring>) {
-                setString(NetWidget::fillEntry(printEntry));
-            }
-        },
-        printEntry);
+void Text::paintEvent(QPaintEvent* event) {
+    QPainter painter(this);
+    painter.setPen(palette().color(QPalette::WindowText));
+
+    // Vertically centered like a QLabel
+    int y = (height() - fontMetrics().height()) / 2;
+
+    const QRect& damaged = event->rect();
+    for (const auto& run : m_runs) {
+        if (run.x > damaged.right()) {
+            break;
+        }
+        if (run.x + run.width > damaged.left()) {
+            painter.drawStaticText(run.x, y, run.staticText);
+        }
+    }
+}
+
+int Text::prepareRun(Run& run) {
+    run.staticText.setTextFormat(Qt::PlainText);
+    run.staticText.setText(run.text);
+    run.staticText.prepare(QTransform(), font());
+
+    return fontMetrics().horizontalAdvance(run.text);
+}
+
+void Text::layoutRuns() {
+    int x = 0;
+    for (auto& run : m_runs) {
+        run.x = x;
+        x += run.width;
+    }
+
+    if (x != m_width) {
+        m_width = x;
+        updateGeometry();
+    }
+    update();
 }
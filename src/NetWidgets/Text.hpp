@@ -2,21 +2,69 @@
 
 #pragma once
 
-#include <QLabel>
+#include <string>
+#include <vector>
+
+#include <QStaticText>
+#include <QString>
+#include <QWidget>
 
 #include "NetWidget.hpp"
 
 /**
- * Provides a wrapper for QLabel
+ * Displays a line of text
+ *
+ * The text is drawn as one pre-shaped QStaticText per run of the update text.
+ * When a value changes, only its run is shaped and repainted. Value runs keep
+ * the widest width they've had, and start with room for the field width in
+ * their format spec, so the widget only relayouts when a value outgrows its
+ * field.
  */
-class Text : public QLabel, public NetWidget {
+class Text : public QWidget, public NetWidget {
     Q_OBJECT
 
 public:
     explicit Text(bool netUpdate, QWidget* parent = nullptr);
 
     void setString(const std::wstring& text);
+    void setString(const QString& text);
     std::wstring getString() const;
 
     void updateEntry() override;
+
+    QSize sizeHint() const override;
+    QSize minimumSizeHint() const override;
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+
+private:
+    struct Run {
+        QString text;
+        QStaticText staticText;
+
+        // Left edge and width reserved for the run
+        int x = 0;
+        int width = 0;
+    };
+
+    std::vector<Run> m_runs;
+
+    // Receives the runs from fillRuns() so their capacity is reused
+    std::vector<QString> m_runTexts;
+
+    // Update text the runs were created for
+    std::wstring m_runTemplate;
+
+    // True if the runs show values rather than the text from setString()
+    bool m_showingValues = false;
+
+    // Sum of the widths of the runs
+    int m_width = 0;
+
+    // Shapes the run's text and returns its width
+    int prepareRun(Run& run);
+
+    // Places the runs left to right and asks the parent to relayout
+    void layoutRuns();
 };
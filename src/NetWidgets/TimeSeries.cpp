@@ -0,0 +1,96 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#include "TimeSeries.hpp"
+
+#include <algorithm>
+
+TimeSeries::TimeSeries(size_t capacity)
+    : m_samples(std::max<size_t>(capacity, 1)) {}
+
+void TimeSeries::reserve(size_t capacity) {
+    if (capacity <= m_samples.size()) {
+        return;
+    }
+
+    /* The head only moves once the buffer is full, so unwrapping the ring
+     * puts the oldest sample at the front in either case
+     */
+    std::rotate(m_samples.begin(), m_samples.begin() + m_head, m_samples.end());
+    m_samples.resize(capacity);
+    m_head = 0;
+}
+
+void TimeSeries::push(double time, double value) {
+    size_t tail = m_head + m_size;
+    if (tail >= m_samples.size()) {
+        tail -= m_samples.size();
+    }
+    m_samples[tail] = {time, value};
+    m_pushCount++;
+
+    if (m_size < m_samples.size()) {
+        m_size++;
+    } else if (++m_head == m_samples.size()) {
+        m_head = 0;
+    }
+}
+
+void TimeSeries::clear() {
+    m_head = 0;
+    m_size = 0;
+}
+
+size_t TimeSeries::size() const { return m_size; }
+
+size_t TimeSeries::capacity() const { return m_samples.size(); }
+
+uint64_t TimeSeries::pushCount() const { return m_pushCount; }
+
+const TimeSeries::Sample& TimeSeries::operator[](size_t index) const {
+    index += m_head;
+    if (index >= m_samples.size()) {
+        index -= m_samples.size();
+    }
+    return m_samples[index];
+}
+
+void TimeSeries::decimate(double start, double end,
+                          std::vector<Bucket>& buckets) const {
+    std::fill(buckets.begin(), buckets.end(), Bucket{});
+    if (buckets.empty() || end <= start) {
+        return;
+    }
+
+    // Samples are in time order, so binary search for the first visible one
+    size_t low = 0;
+    size_t high = m_size;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if ((*this)[mid].time < start) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    double scale = buckets.size() / (end - start);
+    for (size_t i = low; i < m_size; i++) {
+        const auto& sample = (*this)[i];
+        if (sample.time > end) {
+            break;
+        }
+
+        auto column = static_cast<size_t>((sample.time - start) * scale);
+        auto& bucket = buckets[std::min(column, buckets.size() - 1)];
+        if (bucket.count == 0) {
+            bucket.min = sample.value;
+            bucket.max = sample.value;
+            bucket.first = sample.value;
+        } else {
+            bucket.min = std::min(bucket.min, sample.value);
+            bucket.max = std::max(bucket.max, sample.value);
+        }
+        bucket.last = sample.value;
+        bucket.count++;
+    }
+}
@@ -0,0 +1,78 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+/**
+ * Fixed-capacity ring buffer of timestamped samples
+ *
+ * Once full, each new sample overwrites the oldest one. Samples must be pushed
+ * in nondecreasing time order.
+ */
+class TimeSeries {
+public:
+    struct Sample {
+        double time;
+        double value;
+    };
+
+    // Summary of the samples which fall within one column of a plot
+    struct Bucket {
+        size_t count = 0;
+        double min = 0.0;
+        double max = 0.0;
+
+        // Values of the oldest and newest samples in the bucket
+        double first = 0.0;
+        double last = 0.0;
+    };
+
+    explicit TimeSeries(size_t capacity);
+
+    /**
+     * Grows the buffer to hold at least the given number of samples, keeping
+     * the samples already stored
+     */
+    void reserve(size_t capacity);
+
+    void push(double time, double value);
+
+    void clear();
+
+    size_t size() const;
+    size_t capacity() const;
+
+    /**
+     * Returns the number of samples ever pushed, which tells a reader whether
+     * samples arrived since it last looked
+     */
+    uint64_t pushCount() const;
+
+    /**
+     * Returns a sample by age, where 0 is the oldest
+     */
+    const Sample& operator[](size_t index) const;
+
+    /**
+     * Splits [start, end] into buckets.size() equal intervals and summarizes
+     * the samples falling in each
+     *
+     * The cost is proportional to the number of samples in the interval plus
+     * the number of buckets, so plots can draw one vertical line per pixel
+     * column regardless of the sample rate.
+     */
+    void decimate(double start, double end, std::vector<Bucket>& buckets) const;
+
+private:
+    std::vector<Sample> m_samples;
+
+    // Index of the oldest sample
+    size_t m_head = 0;
+    size_t m_size = 0;
+
+    uint64_t m_pushCount = 0;
+};
@@ -0,0 +1,49 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#include "PacketReader.hpp"
+
+PacketReader::PacketReader(const char* data, size_t size, size_t pos)
+    : m_data(data), m_size(size), m_pos(pos) {
+    if (m_pos > m_size) {
+        m_pos = m_size;
+        m_ok = false;
+    }
+}
+
+PacketReader::PacketReader(const std::vector<char>& data, size_t pos)
+    : PacketReader(data.data(), data.size(), pos) {}
+
+std::string_view PacketReader::readString() {
+    auto length = read<uint32_t>();
+
+    size_t pos = m_pos;
+    if (!take(length)) {
+        return {};
+    }
+
+    return std::string_view(m_data + pos, length);
+}
+
+void PacketReader::skip(size_t count) { take(count); }
+
+bool PacketReader::ok() const { return m_ok; }
+
+bool PacketReader::atEnd() const { return !m_ok || m_pos == m_size; }
+
+const char* PacketReader::data() const { return m_data; }
+
+size_t PacketReader::size() const { return m_size; }
+
+size_t PacketReader::position() const { return m_pos; }
+
+size_t PacketReader::remaining() const { return m_size - m_pos; }
+
+bool PacketReader::take(size_t count) {
+    if (!m_ok || count > m_size - m_pos) {
+        m_ok = false;
+        return false;
+    }
+
+    m_pos += count;
+    return true;
+}
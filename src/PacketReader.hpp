@@ -0,0 +1,73 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <string_view>
+#include <vector>
+
+/**
+ * Reads big-endian fields from a received packet without copying it
+ *
+ * A read past the end of the packet puts the reader in an error state. Every
+ * later read fails too and returns zero or an empty string, so a sequence of
+ * reads only needs to check ok() once at the end.
+ */
+class PacketReader {
+public:
+    /**
+     * Reads from the given bytes, starting at pos
+     *
+     * The bytes must outlive the reader and any string_view it returns.
+     */
+    PacketReader(const char* data, size_t size, size_t pos = 0);
+
+    explicit PacketReader(const std::vector<char>& data, size_t pos = 0);
+
+    /**
+     * Reads an integer of type T
+     */
+    template <class T>
+    T read();
+
+    /**
+     * Reads a string prefixed by its 32-bit length
+     *
+     * The result refers to the packet's bytes.
+     */
+    std::string_view readString();
+
+    /**
+     * Skips the given number of bytes
+     */
+    void skip(size_t count);
+
+    // Returns false if a read went past the end of the packet
+    bool ok() const;
+
+    // Returns true if every byte was read or a read failed
+    bool atEnd() const;
+
+    const char* data() const;
+    size_t size() const;
+
+    // Returns the offset of the next byte to read
+    size_t position() const;
+
+    // Returns the number of bytes left to read
+    size_t remaining() const;
+
+private:
+    const char* m_data;
+    size_t m_size;
+    size_t m_pos;
+    bool m_ok = true;
+
+    /* Returns true and advances past the next count bytes if the packet has
+     * them, or enters the error state
+     */
+    bool take(size_t count);
+};
+
+#include "PacketReader.inl"
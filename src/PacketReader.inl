@@ -0,0 +1,29 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#pragma once
+
+#include <type_traits>
+
+#include "DSDisplay/Protocol.hpp"
+
+template <class T>
+T PacketReader::read() {
+    static_assert(std::is_integral_v<T>, "PacketReader only reads integers");
+
+    size_t pos = m_pos;
+    if (!take(sizeof(T))) {
+        return 0;
+    }
+
+    const char* bytes = m_data + pos;
+    if constexpr (sizeof(T) == 1) {
+        return static_cast<T>(static_cast<uint8_t>(bytes[0]));
+    } else if constexpr (sizeof(T) == 2) {
+        return static_cast<T>(Protocol::readU16(bytes));
+    } else if constexpr (sizeof(T) == 4) {
+        return static_cast<T>(Protocol::readU32(bytes));
+    } else {
+        static_assert(sizeof(T) == 8, "Unsupported integer size");
+        return static_cast<T>(Protocol::readU64(bytes));
+    }
+}
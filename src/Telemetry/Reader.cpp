@@ -0,0 +1,113 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#include "Reader.hpp"
+
+#include <fstream>
+#include <iterator>
+
+#include "DSDisplay/Protocol.hpp"
+#include "TelemetryFormat.hpp"
+
+namespace {
+
+std::vector<char> makePacket(Protocol::Opcode opcode) {
+    char header[Protocol::kMaxHeaderSize];
+    size_t size = Protocol::encodeHeader(header, Protocol::kVersion1, opcode);
+    return std::vector<char>(header, header + size);
+}
+
+void appendString(std::vector<char>& packet, const std::string& str) {
+    char length[sizeof(uint32_t)];
+    Protocol::writeU32(length, str.size());
+    packet.insert(packet.end(), length, length + sizeof(length));
+    packet.insert(packet.end(), str.begin(), str.end());
+}
+
+}  // namespace
+
+bool Reader::open(const std::string& fileName) {
+    m_packets.clear();
+    m_truncated = false;
+
+    std::ifstream file(fileName, std::ifstream::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::string contents{std::istreambuf_iterator<char>(file),
+                         std::istreambuf_iterator<char>()};
+
+    if (contents.size() < TelemetryFormat::kFileHeaderSize ||
+        contents.compare(0, sizeof(TelemetryFormat::kMagic),
+                         TelemetryFormat::kMagic,
+                         sizeof(TelemetryFormat::kMagic)) != 0 ||
+        static_cast<uint8_t>(contents[sizeof(TelemetryFormat::kMagic)]) !=
+            TelemetryFormat::kVersion) {
+        return false;
+    }
+
+    std::vector<TelemetryFormat::Row> rows;
+    size_t pos = TelemetryFormat::kFileHeaderSize;
+    while (pos < contents.size()) {
+        if (contents.size() - pos < TelemetryFormat::kBlockHeaderSize) {
+            m_truncated = true;
+            break;
+        }
+
+        auto kind = static_cast<TelemetryFormat::BlockKind>(contents[pos]);
+        uint32_t size = Protocol::readU32(&contents[pos + 1]);
+        uint32_t crc = Protocol::readU32(&contents[pos + 5]);
+        pos += TelemetryFormat::kBlockHeaderSize;
+
+        if (size > contents.size() - pos ||
+            TelemetryFormat::crc32(&contents[pos], size) != crc) {
+            m_truncated = true;
+            break;
+        }
+        std::string payload = contents.substr(pos, size);
+        pos += size;
+
+        if (kind == TelemetryFormat::BlockKind::Layout) {
+            uint64_t time;
+            std::string text;
+            if (TelemetryFormat::decodeLayout(payload, time, text)) {
+                addLayout(time, text);
+            }
+            continue;
+        }
+
+        rows.clear();
+        if (kind != TelemetryFormat::BlockKind::Data ||
+            !TelemetryFormat::decodeData(payload, rows)) {
+            continue;
+        }
+
+        // Rows recorded at the same time came from the same packet
+        for (size_t i = 0; i < rows.size();) {
+            Packet packet{rows[i].time, false,
+                          makePacket(Protocol::Opcode::Display)};
+
+            for (; i < rows.size() && rows[i].time == packet.time &&
+                   packet.data.size() < kMaxPacketSize;
+                 i++) {
+                packet.data.push_back(static_cast<char>(rows[i].type));
+                appendString(packet.data, rows[i].key);
+                packet.data.insert(packet.data.end(), rows[i].value.begin(),
+                                   rows[i].value.end());
+            }
+
+            m_packets.emplace_back(std::move(packet));
+        }
+    }
+
+    return true;
+}
+
+std::vector<Reader::Packet>& Reader::getPackets() { return m_packets; }
+
+bool Reader::isTruncated() const { return m_truncated; }
+
+void Reader::addLayout(uint64_t time, const std::string& text) {
+    Packet packet{time, true, makePacket(Protocol::Opcode::GuiCreate)};
+    appendString(packet.data, text);
+    m_packets.emplace_back(std::move(packet));
+}
@@ -0,0 +1,50 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+/**
+ * Loads a recorded telemetry session as the packets a robot would have sent
+ *
+ * Layouts become guiCreate packets and each group of values recorded at the
+ * same time becomes a display packet. Both use version 1 framing, which names
+ * keys directly, so they can be fed to the display without a key table.
+ */
+class Reader {
+public:
+    struct Packet {
+        // Microseconds since recording started
+        uint64_t time;
+
+        bool isLayout;
+        std::vector<char> data;
+    };
+
+    // Largest display packet built from one group of values
+    static constexpr size_t kMaxPacketSize = 60000;
+
+    /**
+     * Reads the whole file
+     *
+     * Blocks after a corrupt or truncated one are ignored.
+     *
+     * @return false if the file couldn't be read or isn't a telemetry file
+     */
+    bool open(const std::string& fileName);
+
+    // Packets are in time order and may be moved out by the caller
+    std::vector<Packet>& getPackets();
+
+    // Returns true if reading stopped at a corrupt or truncated block
+    bool isTruncated() const;
+
+private:
+    std::vector<Packet> m_packets;
+    bool m_truncated = false;
+
+    void addLayout(uint64_t time, const std::string& text);
+};
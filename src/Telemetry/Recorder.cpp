@@ -0,0 +1,179 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#include "Recorder.hpp"
+
+#include <fstream>
+#include <utility>
+
+Recorder::Recorder(std::string fileName)
+    : m_fileName(std::move(fileName)),
+      m_keys(std::make_shared<std::vector<std::string>>()),
+      m_writeThread(&Recorder::writeLoop, this) {
+    reserveBlock();
+}
+
+Recorder::~Recorder() {
+    flush();
+
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_stop = true;
+    }
+    m_queueCV.notify_one();
+    m_writeThread.join();
+}
+
+void Recorder::addLayout(std::string_view text) {
+    beginPacket();
+
+    // Rows recorded before the layout changed belong to the old one
+    flush();
+
+    // The new layout's keys are interned as they're first recorded
+    m_keyIds.clear();
+    m_keys = std::make_shared<std::vector<std::string>>();
+    m_keysQueued = false;
+
+    Block block;
+    block.kind = TelemetryFormat::BlockKind::Layout;
+    block.time = m_packetTime;
+    block.text = text;
+    queue(std::move(block));
+}
+
+void Recorder::beginPacket() {
+    auto time = steady_clock::now();
+    m_packetTime = std::chrono::duration_cast<std::chrono::microseconds>(
+                       time - m_startTime)
+                       .count();
+
+    if (!m_entries.empty() && time - m_blockStart >= kBlockAge) {
+        flush();
+    }
+}
+
+void Recorder::addValue(const std::string& key, Protocol::ValueType type,
+                        const char* value, size_t size) {
+    if (m_entries.empty()) {
+        m_blockStart = steady_clock::now();
+    }
+
+    auto keyId = m_keyIds.find(key);
+    if (keyId == m_keyIds.end()) {
+        if (m_keysQueued) {
+            m_keys = std::make_shared<std::vector<std::string>>(*m_keys);
+            m_keysQueued = false;
+        }
+        keyId = m_keyIds.emplace(key, m_keys->size()).first;
+        m_keys->emplace_back(key);
+    }
+
+    m_entries.push_back({m_packetTime, keyId->second, type,
+                         static_cast<uint32_t>(m_values.size()),
+                         static_cast<uint32_t>(size)});
+    m_values.append(value, size);
+
+    if (m_entries.size() >= kBlockRows ||
+        m_values.size() >= kBlockValueBytes) {
+        flush();
+    }
+}
+
+void Recorder::flush() {
+    if (m_entries.empty()) {
+        return;
+    }
+
+    Block block;
+    block.kind = TelemetryFormat::BlockKind::Data;
+    block.entries = std::move(m_entries);
+    block.values = std::move(m_values);
+    block.keys = m_keys;
+    m_keysQueued = true;
+    queue(std::move(block));
+
+    reserveBlock();
+}
+
+const std::string& Recorder::getFileName() const { return m_fileName; }
+
+size_t Recorder::getDroppedBlocks() const { return m_droppedBlocks; }
+
+bool Recorder::hasFailed() const { return m_failed; }
+
+void Recorder::queue(Block&& block) {
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+
+        // Data blocks after a lost layout couldn't be interpreted
+        if (block.kind == TelemetryFormat::BlockKind::Data &&
+            m_queue.size() >= kMaxQueuedBlocks) {
+            m_droppedBlocks++;
+            return;
+        }
+        m_queue.emplace_back(std::move(block));
+    }
+    m_queueCV.notify_one();
+}
+
+void Recorder::reserveBlock() {
+    m_entries.clear();
+    m_entries.reserve(kBlockRows);
+    m_values.clear();
+    m_values.reserve(kBlockValueBytes);
+}
+
+void Recorder::writeLoop() {
+    std::ofstream file;
+    std::vector<TelemetryFormat::Row> rows;
+
+    std::unique_lock<std::mutex> lock(m_queueMutex);
+    while (true) {
+        m_queueCV.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+        if (m_queue.empty()) {
+            break;
+        }
+
+        Block block = std::move(m_queue.front());
+        m_queue.pop_front();
+        lock.unlock();
+
+        if (!file.is_open() && !m_failed) {
+            file.open(m_fileName, std::ofstream::binary | std::ofstream::trunc);
+            if (file.is_open()) {
+                file << TelemetryFormat::encodeFileHeader();
+            } else {
+                m_failed = true;
+            }
+        }
+
+        if (file.is_open()) {
+            std::string payload;
+            if (block.kind == TelemetryFormat::BlockKind::Layout) {
+                payload = TelemetryFormat::encodeLayout(block.time, block.text);
+            } else {
+                // Rows are expanded here, off the caller's thread
+                rows.resize(block.entries.size());
+                for (size_t i = 0; i < rows.size(); i++) {
+                    const auto& entry = block.entries[i];
+                    rows[i].time = entry.time;
+                    rows[i].key = (*block.keys)[entry.keyId];
+                    rows[i].type = entry.type;
+                    rows[i].value.assign(block.values, entry.valuePos,
+                                         entry.valueSize);
+                }
+                payload = TelemetryFormat::encodeData(rows);
+            }
+
+            // Flushed per block so a crash loses as little as possible
+            file << TelemetryFormat::encodeBlock(block.kind, payload);
+            file.flush();
+            if (!file) {
+                m_failed = true;
+                file.close();
+            }
+        }
+
+        lock.lock();
+    }
+}
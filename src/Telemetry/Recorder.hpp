@@ -0,0 +1,136 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "DSDisplay/Protocol.hpp"
+#include "TelemetryFormat.hpp"
+
+/**
+ * Records received telemetry to a file in the TelemetryFormat
+ *
+ * Updates are collected into blocks on the calling thread, which only copies
+ * them. Keys are interned to IDs once per layout and values are appended to a
+ * preallocated buffer, so recording an update doesn't allocate. Encoding,
+ * checksumming, and writing happen on a background thread. At
+ * most kMaxQueuedBlocks data blocks wait to be written; if the disk falls
+ * further behind than that, new ones are dropped instead of blocking the
+ * caller. Layout blocks are small and rare, so they're always queued.
+ *
+ * The file is created when the first block is written.
+ */
+class Recorder {
+public:
+    // Rows after which a data block is queued for writing
+    static constexpr size_t kBlockRows = 4096;
+
+    // Value bytes after which a data block is queued, enough for doubles
+    static constexpr size_t kBlockValueBytes = kBlockRows * sizeof(double);
+
+    // Longest time rows wait before being queued, bounding loss on a crash
+    static constexpr std::chrono::seconds kBlockAge{1};
+
+    static constexpr size_t kMaxQueuedBlocks = 32;
+
+    explicit Recorder(std::string fileName);
+
+    // Writes the remaining blocks before returning
+    ~Recorder();
+
+    Recorder(const Recorder&) = delete;
+    Recorder& operator=(const Recorder&) = delete;
+
+    /**
+     * Records the GUISettings.txt text the following updates are for
+     */
+    void addLayout(std::string_view text);
+
+    /**
+     * Starts a packet. Values added until the next call share its time.
+     */
+    void beginPacket();
+
+    /**
+     * Records a value in its version 1 wire format
+     */
+    void addValue(const std::string& key, Protocol::ValueType type,
+                  const char* value, size_t size);
+
+    /**
+     * Queues the rows collected so far for writing
+     */
+    void flush();
+
+    const std::string& getFileName() const;
+
+    // Returns the number of data blocks dropped because the queue was full
+    size_t getDroppedBlocks() const;
+
+    // Returns true if the file couldn't be created or written
+    bool hasFailed() const;
+
+private:
+    using steady_clock = std::chrono::steady_clock;
+
+    // A row whose key is interned and whose value is in the block's buffer
+    struct Entry {
+        uint64_t time;
+        uint32_t keyId;
+        Protocol::ValueType type;
+        uint32_t valuePos;
+        uint32_t valueSize;
+    };
+
+    struct Block {
+        TelemetryFormat::BlockKind kind;
+        std::vector<Entry> entries;
+        std::string values;
+        std::shared_ptr<const std::vector<std::string>> keys;
+        uint64_t time = 0;
+        std::string text;
+    };
+
+    std::string m_fileName;
+    steady_clock::time_point m_startTime = steady_clock::now();
+
+    // Owned by the caller's thread
+    std::unordered_map<std::string, uint32_t> m_keyIds;
+
+    // Shared with queued blocks, so it's copied when a key is added after one
+    std::shared_ptr<std::vector<std::string>> m_keys;
+    bool m_keysQueued = false;
+    std::vector<Entry> m_entries;
+    std::string m_values;
+    uint64_t m_packetTime = 0;
+    steady_clock::time_point m_blockStart;
+
+    std::mutex m_queueMutex;
+    std::condition_variable m_queueCV;
+    std::deque<Block> m_queue;
+    bool m_stop = false;
+
+    std::atomic<size_t> m_droppedBlocks{0};
+    std::atomic<bool> m_failed{false};
+
+    std::thread m_writeThread;
+
+    void queue(Block&& block);
+
+    // Allocates the next block's buffers
+    void reserveBlock();
+
+    void writeLoop();
+};
@@ -0,0 +1,95 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#include "Replay.hpp"
+
+#include <utility>
+
+Replay::Replay(Reader& reader) : m_packets(std::move(reader.getPackets())) {
+    if (!m_packets.empty()) {
+        m_basePosition = m_packets[0].time;
+    }
+}
+
+void Replay::setSpeed(double speed) {
+    // Continue from the current position at the new speed
+    m_basePosition = getPosition();
+    m_baseTime = steady_clock::now();
+    m_speed = speed;
+}
+
+double Replay::getSpeed() const { return m_speed; }
+
+void Replay::seek(uint64_t time) {
+    // Start from the layout in effect at the target time
+    m_next = 0;
+    for (size_t i = 0; i < m_packets.size() && m_packets[i].time <= time;
+         i++) {
+        if (m_packets[i].isLayout) {
+            m_next = i;
+        }
+    }
+
+    m_catchUpTime = time;
+    m_basePosition = time;
+    m_baseTime = steady_clock::now();
+}
+
+bool Replay::poll(const std::function<void(std::vector<char>&)>& deliver) {
+    auto startTime = steady_clock::now();
+
+    if (m_speed > 0.0) {
+        uint64_t position = getPosition();
+        while (m_next < m_packets.size() &&
+               (m_packets[m_next].time <= position ||
+                m_packets[m_next].time <= m_catchUpTime)) {
+            deliver(m_packets[m_next].data);
+            m_next++;
+        }
+    } else {
+        /* Deliver in batches so the event loop can still run, checking the
+         * clock only occasionally to keep its cost out of the measurement
+         */
+        while (m_next < m_packets.size()) {
+            auto& packet = m_packets[m_next];
+            deliver(packet.data);
+            m_next++;
+
+            m_throughput.packets++;
+            m_throughput.bytes += packet.data.size();
+
+            if (m_throughput.packets % 64 == 0 &&
+                steady_clock::now() - startTime >= kMaxPollTime) {
+                break;
+            }
+        }
+
+        // Keep the position in step with the packets delivered
+        m_basePosition = m_next > 0 ? m_packets[m_next - 1].time : 0;
+        m_baseTime = steady_clock::now();
+        m_throughput.seconds +=
+            std::chrono::duration<double>(m_baseTime - startTime).count();
+    }
+
+    return m_next < m_packets.size();
+}
+
+uint64_t Replay::getPosition() const {
+    if (m_speed <= 0.0) {
+        return m_basePosition;
+    }
+
+    auto elapsed = std::chrono::duration<double, std::micro>(
+                       steady_clock::now() - m_baseTime)
+                       .count();
+    uint64_t position =
+        m_basePosition + static_cast<uint64_t>(elapsed * m_speed);
+    return position < getDuration() ? position : getDuration();
+}
+
+uint64_t Replay::getDuration() const {
+    return m_packets.empty() ? 0 : m_packets.back().time;
+}
+
+const Replay::Throughput& Replay::getThroughput() const {
+    return m_throughput;
+}
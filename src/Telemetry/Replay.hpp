@@ -0,0 +1,83 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <chrono>
+#include <functional>
+#include <vector>
+
+#include "Reader.hpp"
+
+/**
+ * Plays back the packets of a recorded session on a clock
+ *
+ * Call poll() regularly to receive the packets which are due. At a speed of
+ * zero, packets are delivered as fast as the receiver can process them and
+ * the achieved throughput is measured.
+ */
+class Replay {
+public:
+    struct Throughput {
+        size_t packets = 0;
+        size_t bytes = 0;
+
+        // Time spent delivering packets in seconds
+        double seconds = 0.0;
+    };
+
+    // Longest time poll() spends delivering packets as fast as possible
+    static constexpr std::chrono::milliseconds kMaxPollTime{50};
+
+    // Takes the packets loaded by the reader
+    explicit Replay(Reader& reader);
+
+    /**
+     * Sets the playback speed as a multiple of real time, or zero for as fast
+     * as possible
+     */
+    void setSpeed(double speed);
+    double getSpeed() const;
+
+    /**
+     * Moves playback to the given time in microseconds
+     *
+     * The layout in effect at that time and every packet between it and the
+     * target are delivered by the next poll() so the display's state matches
+     * what it was at that time.
+     */
+    void seek(uint64_t time);
+
+    /**
+     * Delivers every packet which is due
+     *
+     * @return false once every packet has been delivered
+     */
+    bool poll(const std::function<void(std::vector<char>&)>& deliver);
+
+    // Returns the current playback time in microseconds
+    uint64_t getPosition() const;
+
+    uint64_t getDuration() const;
+
+    const Throughput& getThroughput() const;
+
+private:
+    using steady_clock = std::chrono::steady_clock;
+
+    std::vector<Reader::Packet> m_packets;
+
+    // Index of the next packet to deliver
+    size_t m_next = 0;
+    double m_speed = 1.0;
+
+    // Packets up to this time are delivered immediately after a seek
+    uint64_t m_catchUpTime = 0;
+
+    // Playback time at m_baseTime
+    uint64_t m_basePosition = 0;
+    steady_clock::time_point m_baseTime = steady_clock::now();
+
+    Throughput m_throughput;
+};
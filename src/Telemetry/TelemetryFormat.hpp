@@ -0,0 +1,315 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#pragma once
+
+#include <stdint.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "DSDisplay/Protocol.hpp"
+
+/**
+ * On-disk format of recorded telemetry sessions
+ *
+ * A file starts with kMagic and the format version, followed by blocks which
+ * are only ever appended. Each block is a kind byte, a uint32 payload size, a
+ * uint32 CRC-32 of the payload, and the payload. A reader which finds a bad
+ * checksum or a truncated block at the end of the file (for example, after a
+ * crash) keeps every block before it.
+ *
+ * Layout blocks hold a uint64 time and the GUISettings.txt text the robot sent
+ * at that time.
+ *
+ * Data blocks hold rows of key/value updates stored column by column, which
+ * groups similar bytes together:
+ *
+ * 1. uint64 time of the first row
+ * 2. varint row count
+ * 3. dictionary: varint key count, then a varint length and bytes per key
+ * 4. time column: varint difference from the previous row's time per row
+ * 5. key column: varint dictionary index per row
+ * 6. type column: Protocol::ValueType tag per row
+ * 7. value column: per row, a byte for Char, a zigzag varint for Int32, a
+ *    varint length and bytes for String, and eight bytes for Double
+ *
+ * Times are in microseconds since recording started. Values received in the
+ * same packet share a time. Fixed-size integers are big endian like the
+ * network protocol.
+ */
+namespace TelemetryFormat {
+
+constexpr char kMagic[4] = {'D', 'S', 'T', 'L'};
+constexpr uint8_t kVersion = 1;
+
+constexpr size_t kFileHeaderSize = sizeof(kMagic) + 1;
+constexpr size_t kBlockHeaderSize = 9;
+
+enum class BlockKind : uint8_t { Layout = 'L', Data = 'D' };
+
+/* One recorded update. The value is kept in its wire format (a byte, a big
+ * endian int32 or double, or a uint32 length and bytes) so it can be replayed
+ * without conversion.
+ */
+struct Row {
+    uint64_t time = 0;
+    std::string key;
+    Protocol::ValueType type = Protocol::ValueType::Int32;
+    std::string value;
+};
+
+inline uint32_t crc32(const char* data, size_t size) {
+    static const auto table = [] {
+        std::vector<uint32_t> table(256);
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; bit++) {
+                crc = (crc >> 1) ^ (crc & 1 ? 0xEDB88320u : 0);
+            }
+            table[i] = crc;
+        }
+        return table;
+    }();
+
+    uint32_t crc = 0xffffffffu;
+    for (size_t i = 0; i < size; i++) {
+        crc = table[(crc ^ static_cast<uint8_t>(data[i])) & 0xff] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+inline void writeVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+inline bool readVarint(const std::string& in, size_t& pos, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && pos < in.size(); shift += 7) {
+        auto byte = static_cast<uint8_t>(in[pos++]);
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+inline void writeU64(std::string& out, uint64_t value) {
+    char buf[8];
+    Protocol::writeU32(buf, value >> 32);
+    Protocol::writeU32(buf + 4, value);
+    out.append(buf, sizeof(buf));
+}
+
+inline bool readU64(const std::string& in, size_t& pos, uint64_t& value) {
+    if (in.size() - pos < 8) {
+        return false;
+    }
+    value = static_cast<uint64_t>(Protocol::readU32(&in[pos])) << 32 |
+            Protocol::readU32(&in[pos + 4]);
+    pos += 8;
+    return true;
+}
+
+/**
+ * Returns the file header which precedes the first block
+ */
+inline std::string encodeFileHeader() {
+    std::string out(kMagic, sizeof(kMagic));
+    out.push_back(static_cast<char>(kVersion));
+    return out;
+}
+
+/**
+ * Wraps a payload in a block header with its checksum
+ */
+inline std::string encodeBlock(BlockKind kind, const std::string& payload) {
+    char header[kBlockHeaderSize];
+    header[0] = static_cast<char>(kind);
+    Protocol::writeU32(header + 1, payload.size());
+    Protocol::writeU32(header + 5, crc32(payload.data(), payload.size()));
+
+    std::string out(header, sizeof(header));
+    out += payload;
+    return out;
+}
+
+inline std::string encodeLayout(uint64_t time, const std::string& text) {
+    std::string payload;
+    writeU64(payload, time);
+    payload += text;
+    return payload;
+}
+
+inline bool decodeLayout(const std::string& payload, uint64_t& time,
+                         std::string& text) {
+    size_t pos = 0;
+    if (!readU64(payload, pos, time)) {
+        return false;
+    }
+    text = payload.substr(pos);
+    return true;
+}
+
+/**
+ * Encodes rows, which must be in nondecreasing time order, as a data block
+ * payload
+ */
+inline std::string encodeData(const std::vector<Row>& rows) {
+    std::string payload;
+    writeU64(payload, rows.empty() ? 0 : rows[0].time);
+    writeVarint(payload, rows.size());
+
+    // Each block has its own dictionary so blocks can be decoded alone
+    std::unordered_map<std::string, uint32_t> indices;
+    std::vector<const std::string*> dictionary;
+    std::vector<uint32_t> keyColumn;
+    keyColumn.reserve(rows.size());
+    for (const auto& row : rows) {
+        // Looked up first since emplace() copies the key even if it's present
+        auto index = indices.find(row.key);
+        if (index == indices.end()) {
+            index = indices.emplace(row.key, dictionary.size()).first;
+            dictionary.push_back(&row.key);
+        }
+        keyColumn.push_back(index->second);
+    }
+
+    writeVarint(payload, dictionary.size());
+    for (auto key : dictionary) {
+        writeVarint(payload, key->size());
+        payload += *key;
+    }
+
+    uint64_t prevTime = rows.empty() ? 0 : rows[0].time;
+    for (const auto& row : rows) {
+        writeVarint(payload, row.time - prevTime);
+        prevTime = row.time;
+    }
+
+    for (auto index : keyColumn) {
+        writeVarint(payload, index);
+    }
+
+    for (const auto& row : rows) {
+        payload.push_back(static_cast<char>(row.type));
+    }
+
+    for (const auto& row : rows) {
+        if (row.type == Protocol::ValueType::Int32) {
+            auto value = static_cast<int32_t>(Protocol::readU32(&row.value[0]));
+
+            // Zigzag encoding keeps small negative numbers short
+            writeVarint(payload, (static_cast<uint32_t>(value) << 1) ^
+                                     static_cast<uint32_t>(value >> 31));
+        } else if (row.type == Protocol::ValueType::String) {
+            writeVarint(payload, row.value.size() - sizeof(uint32_t));
+            payload.append(row.value, sizeof(uint32_t), std::string::npos);
+        } else {
+            payload += row.value;
+        }
+    }
+
+    return payload;
+}
+
+/**
+ * Decodes a data block payload, appending its rows
+ *
+ * @return false if the payload is malformed
+ */
+inline bool decodeData(const std::string& payload, std::vector<Row>& rows) {
+    size_t pos = 0;
+    uint64_t time;
+    uint64_t count;
+    uint64_t keyCount;
+    if (!readU64(payload, pos, time) || !readVarint(payload, pos, count) ||
+        count > payload.size() || !readVarint(payload, pos, keyCount) ||
+        keyCount > payload.size()) {
+        return false;
+    }
+
+    std::vector<std::string> dictionary(keyCount);
+    for (auto& key : dictionary) {
+        uint64_t length;
+        if (!readVarint(payload, pos, length) ||
+            length > payload.size() - pos) {
+            return false;
+        }
+        key.assign(payload, pos, length);
+        pos += length;
+    }
+
+    size_t first = rows.size();
+    rows.resize(first + count);
+
+    for (size_t i = first; i < rows.size(); i++) {
+        uint64_t delta;
+        if (!readVarint(payload, pos, delta)) {
+            return false;
+        }
+        time += delta;
+        rows[i].time = time;
+    }
+
+    for (size_t i = first; i < rows.size(); i++) {
+        uint64_t index;
+        if (!readVarint(payload, pos, index) || index >= dictionary.size()) {
+            return false;
+        }
+        rows[i].key = dictionary[index];
+    }
+
+    if (payload.size() - pos < count) {
+        return false;
+    }
+    for (size_t i = first; i < rows.size(); i++) {
+        rows[i].type = static_cast<Protocol::ValueType>(payload[pos++]);
+    }
+
+    for (size_t i = first; i < rows.size(); i++) {
+        auto& row = rows[i];
+        if (row.type == Protocol::ValueType::Char) {
+            if (pos >= payload.size()) {
+                return false;
+            }
+            row.value.assign(1, payload[pos++]);
+        } else if (row.type == Protocol::ValueType::Int32) {
+            uint64_t zigzag;
+            if (!readVarint(payload, pos, zigzag)) {
+                return false;
+            }
+            auto value = static_cast<uint32_t>(zigzag >> 1) ^
+                         -static_cast<uint32_t>(zigzag & 1);
+            row.value.resize(sizeof(uint32_t));
+            Protocol::writeU32(&row.value[0], value);
+        } else if (row.type == Protocol::ValueType::String) {
+            uint64_t length;
+            if (!readVarint(payload, pos, length) ||
+                length > payload.size() - pos) {
+                return false;
+            }
+            row.value.resize(sizeof(uint32_t));
+            Protocol::writeU32(&row.value[0], length);
+            row.value.append(payload, pos, length);
+            pos += length;
+        } else if (row.type == Protocol::ValueType::Double) {
+            if (payload.size() - pos < sizeof(double)) {
+                return false;
+            }
+            row.value.assign(payload, pos, sizeof(double));
+            pos += sizeof(double);
+        } else {
+            return false;
+        }
+    }
+
+    return pos == payload.size();
+}
+
+}  // namespace TelemetryFormat
@@ -2,23 +2,149 @@
 
 #include "Util.hpp"
 
-bool packetToVar(const std::vector<char>& data, size_t& pos,
-                 std::string& dest) {
-    if (pos + sizeof(uint32_t) <= data.size()) {
-        uint32_t size = qFromBigEndian<uint32_t>(
-            reinterpret_cast<const uint8_t*>(&data[pos]));
-        pos += sizeof(size);
-
-        if (pos + size <= data.size()) {
-            dest.assign(&data[pos], size);
-            pos += size;
+#include <stdint.h>
 
+namespace {
+// Returns true if c is one of the ASCII characters in chars
+template <class Char>
+bool isOneOf(Char c, const char* chars) {
+    for (; *chars != '\0'; chars++) {
+        if (c == static_cast<Char>(*chars)) {
             return true;
         }
     }
-
-    /* Return false if either size of string or string data couldn't be
-     * extracted
-     */
     return false;
 }
+
+template <class Char>
+bool isDigit(Char c) {
+    return c >= static_cast<Char>('0') && c <= static_cast<Char>('9');
+}
+
+template <class Char>
+bool scanSpec(std::basic_string_view<Char> text, size_t pos,
+              FormatSpec& spec) {
+    // Skips the '%'
+    pos++;
+
+    bool leftAlign = false;
+    while (pos < text.size() && isOneOf(text[pos], "-+0#")) {
+        leftAlign = leftAlign || text[pos] == static_cast<Char>('-');
+        pos++;
+    }
+
+    // Reads digits at pos into value, returning false if there are too many
+    auto readNumber = [&](int& value) {
+        size_t digitsStart = pos;
+        value = 0;
+        while (pos < text.size() && isDigit(text[pos])) {
+            if (pos - digitsStart < kMaxFormatDigits) {
+                value = value * 10 + (text[pos] - static_cast<Char>('0'));
+            }
+            pos++;
+        }
+        return pos - digitsStart <= kMaxFormatDigits;
+    };
+
+    int width;
+    bool supported = readNumber(width);
+
+    int precision = -1;
+    if (pos < text.size() && text[pos] == static_cast<Char>('.')) {
+        pos++;
+        supported = readNumber(precision) && supported;
+    }
+
+    if (pos >= text.size() || !isOneOf(text[pos], "sdifeEgGxX")) {
+        return false;
+    }
+
+    spec.end = pos + 1;
+    spec.supported = supported;
+    spec.width = width;
+    spec.precision = precision;
+    spec.leftAlign = leftAlign;
+    return true;
+}
+
+// Decodes UTF-8 into dest, which has room for src.size() code units
+template <class Char>
+size_t decode(std::string_view src, Char* dest) {
+    // Smallest code point each sequence length may encode
+    static const uint32_t kMinCodePoint[] = {0, 0x80, 0x800, 0x10000};
+
+    Char* out = dest;
+    size_t pos = 0;
+    while (pos < src.size()) {
+        // Runs of ASCII are copied directly
+        while (pos < src.size() && static_cast<uint8_t>(src[pos]) < 0x80) {
+            *out++ = static_cast<Char>(src[pos++]);
+        }
+        if (pos == src.size()) {
+            break;
+        }
+
+        auto byte = static_cast<uint8_t>(src[pos++]);
+        uint32_t codePoint;
+        int extra;
+        if ((byte & 0xe0) == 0xc0) {
+            codePoint = byte & 0x1f;
+            extra = 1;
+        } else if ((byte & 0xf0) == 0xe0) {
+            codePoint = byte & 0x0f;
+            extra = 2;
+        } else if ((byte & 0xf8) == 0xf0) {
+            codePoint = byte & 0x07;
+            extra = 3;
+        } else {
+            *out++ = static_cast<Char>(0xfffd);
+            continue;
+        }
+
+        int i = 0;
+        for (; i < extra && pos < src.size() &&
+               (static_cast<uint8_t>(src[pos]) & 0xc0) == 0x80;
+             i++, pos++) {
+            codePoint = codePoint << 6 | (src[pos] & 0x3f);
+        }
+
+        // Truncated, overlong, surrogate, and out of range sequences
+        if (i < extra || codePoint < kMinCodePoint[extra] ||
+            codePoint > 0x10ffff ||
+            (codePoint >= 0xd800 && codePoint <= 0xdfff)) {
+            *out++ = static_cast<Char>(0xfffd);
+            continue;
+        }
+
+        // UTF-16 (and wchar_t on Windows) needs a surrogate pair
+        if (sizeof(Char) == 2 && codePoint >= 0x10000) {
+            codePoint -= 0x10000;
+            *out++ = static_cast<Char>(0xd800 + (codePoint >> 10));
+            *out++ = static_cast<Char>(0xdc00 + (codePoint & 0x3ff));
+        } else {
+            *out++ = static_cast<Char>(codePoint);
+        }
+    }
+
+    return out - dest;
+}
+}  // namespace
+
+void appendUtf8(std::wstring& dest, std::string_view src) {
+    // Decoding never produces more code units than there are bytes
+    size_t size = dest.size();
+    dest.resize(size + src.size());
+    dest.resize(size + decode(src, &dest[size]));
+}
+
+size_t decodeUtf8(std::string_view src, char16_t* dest) {
+    return decode(src, dest);
+}
+
+bool scanFormatSpec(std::string_view text, size_t pos, FormatSpec& spec) {
+    return scanSpec(text, pos, spec);
+}
+
+bool scanFormatSpec(std::wstring_view text, size_t pos, FormatSpec& spec) {
+    return scanSpec(text, pos, spec);
+}
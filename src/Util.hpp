@@ -2,16 +2,55 @@
 
 #pragma once
 
-#include <stdint.h>
-
 #include <string>
-#include <vector>
+#include <string_view>
 
 // Contains miscellaneous utility functions
 
-template <class T>
-bool packetToVar(const std::vector<char>& data, size_t& pos, T& dest);
+/**
+ * Appends UTF-8 text to a wide string, replacing invalid sequences with U+FFFD
+ *
+ * Runs of ASCII, which most text from the robot is, are copied directly.
+ */
+void appendUtf8(std::wstring& dest, std::string_view src);
+
+/**
+ * Decodes UTF-8 text into UTF-16 like appendUtf8()
+ *
+ * dest must have room for src.size() code units, which is the most decoding
+ * can produce.
+ *
+ * @return Number of code units written
+ */
+size_t decodeUtf8(std::string_view src, char16_t* dest);
+
+// Longest width or precision a format spec may have, so results stay short
+constexpr size_t kMaxFormatDigits = 2;
+
+struct FormatSpec {
+    // Index after the spec
+    size_t end = 0;
+
+    // False if the width or precision has more than kMaxFormatDigits digits
+    bool supported = false;
+
+    // Minimum number of characters, or 0 if the spec has no width
+    int width = 0;
+
+    // Precision, or -1 if the spec has none
+    int precision = -1;
 
-bool packetToVar(const std::vector<char>& data, size_t& pos, std::string& dest);
+    // True if the '-' flag pads on the right instead of the left
+    bool leftAlign = false;
+};
 
-#include "Util.inl"
+/**
+ * Scans the printf-style format spec starting with the '%' at pos
+ *
+ * A spec is optional flags from "-+0#", an optional width, an optional '.'
+ * and precision, and one of the conversions in "sdifeEgGxX".
+ *
+ * @return false if no spec starts at pos
+ */
+bool scanFormatSpec(std::string_view text, size_t pos, FormatSpec& spec);
+bool scanFormatSpec(std::wstring_view text, size_t pos, FormatSpec& spec);
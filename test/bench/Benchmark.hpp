@@ -0,0 +1,44 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#pragma once
+
+#include <stddef.h>
+
+/**
+ * A minimal benchmark runner
+ *
+ * BENCHMARK(Name) { ... } registers a function which runs the measured code
+ * state.iterations times. The runner grows the iteration count until a run
+ * takes long enough to time, then reports the time and heap allocations per
+ * iteration.
+ */
+namespace bench {
+
+struct State {
+    // Number of times the function should run the measured code
+    size_t iterations = 0;
+
+    // Bytes produced or consumed per iteration, reported if nonzero
+    size_t bytes = 0;
+};
+
+using Function = void (*)(State& state);
+
+struct Registration {
+    Registration(const char* name, Function function);
+};
+
+/**
+ * Keeps the compiler from optimizing away the computation of value
+ */
+template <class T>
+inline void DoNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+}  // namespace bench
+
+#define BENCHMARK(name)                                          \
+    static void name(bench::State& state);                       \
+    static bench::Registration name##Registration_(#name, name); \
+    static void name(bench::State& state)
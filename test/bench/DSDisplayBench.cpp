@@ -0,0 +1,144 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#include <stdint.h>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "DSDisplay/DSDisplay.hpp"
+#include "DSDisplay/Protocol.hpp"
+#include "DSDisplay/Schema.hpp"
+#include "DSDisplay/UdpSocket.hpp"
+
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr uint16_t kV1Port = 5810;
+constexpr uint16_t kV2Port = 5811;
+constexpr uint32_t kLoopback = 0x7F000001;
+
+constexpr auto kLayout = Schema::MakeLayout(
+    Schema::ProgressBar<int32_t>("EV_POS_DISP", "EV_POS", Schema::kLeft,
+                                 "Elevator Height: 0", "Elevator Height: %s"),
+    Schema::Text<double>("ENCODER_LEFT", Schema::kLeft, "Encoder Left: 0",
+                         "Encoder Left: %s"),
+    Schema::Text<double>("ENCODER_RIGHT", Schema::kLeft, "Encoder Right: 0",
+                         "Encoder Right: %s"),
+    Schema::StatusLight("INTAKE_ARMS_CLOSED", Schema::kRight, "Intake Closed",
+                        "Intake Closed"),
+    Schema::StatusLight("CONTAINER_GRABBER_CLOSED", Schema::kRight,
+                        "Container Grabber Closed",
+                        "Container Grabber Closed"));
+
+/* Constructs a display without its message about autonMode.txt. Like robot
+ * code, it has an autonomous mode, which answering Connect requires.
+ */
+std::unique_ptr<DSDisplay> MakeDisplay(uint16_t port) {
+    auto buf = std::cout.rdbuf(nullptr);
+    auto display = std::make_unique<DSDisplay>(port);
+    std::cout.rdbuf(buf);
+
+    display->SetLayout<kLayout>();
+    display->AddAutoMethod("Idle", [] {}, [] {});
+    return display;
+}
+
+/* Connects a Driver Station offering the given version to a display. The
+ * reply to Connect is sent after the key IDs are assigned, so receiving it
+ * means the next packet is encoded with them.
+ */
+std::unique_ptr<DSDisplay> MakeConnectedDisplay(uint16_t port,
+                                                uint8_t version) {
+    auto display = MakeDisplay(port);
+
+    char data[Protocol::kMaxHeaderSize] = {};
+    size_t size = Protocol::encodeCommand(data, Protocol::kVersion1,
+                                          Protocol::Opcode::Connect);
+    data[size - 1] = static_cast<char>(version);
+
+    UdpSocket socket;
+    socket.bind(UdpSocket::kAnyPort);
+    socket.setBlocking(false);
+    socket.send(data, size, kLoopback, port);
+
+    std::vector<char> reply(UdpSocket::kMaxDatagramSize);
+    size_t received;
+    uint32_t address;
+    uint16_t remotePort;
+    for (int i = 0; i < 100; i++) {
+        if (socket.receive(reply.data(), reply.size(), received, address,
+                           remotePort) == UdpSocket::Done) {
+            break;
+        }
+        std::this_thread::sleep_for(10ms);
+    }
+
+    return display;
+}
+
+// A display which a version 1 Driver Station connected to
+DSDisplay& V1Display() {
+    static auto display = MakeConnectedDisplay(kV1Port, Protocol::kVersion1);
+    return *display;
+}
+
+// A display which a version 2 Driver Station connected to
+DSDisplay& V2Display() {
+    static auto display = MakeConnectedDisplay(kV2Port, Protocol::kVersion2);
+    return *display;
+}
+
+/* Adds and sends the values test/src/Main.cpp sends each period. Version 2
+ * packets are built from the key slots by SendToDS(), so the send is part of
+ * each iteration for both versions.
+ */
+void AddValues(DSDisplay& display, bench::State& state) {
+    for (size_t i = 0; i < state.iterations; i++) {
+        display.AddData("ENCODER_LEFT", -3.5);
+        display.AddData("ENCODER_RIGHT", -3.1);
+        display.AddData("EV_POS_DISP", 42);
+        display.AddData("EV_POS", 100 * 42 / 60);
+        display.AddData("INTAKE_ARMS_CLOSED", false);
+        display.AddData("CONTAINER_GRABBER_CLOSED", true);
+        display.SendToDS();
+    }
+}
+
+/* Adds the same values with std::string keys, which is what passing string
+ * literals to the former const std::string& parameters constructed
+ */
+void AddValuesStringKeys(DSDisplay& display, bench::State& state) {
+    for (size_t i = 0; i < state.iterations; i++) {
+        display.AddData(std::string("ENCODER_LEFT"), -3.5);
+        display.AddData(std::string("ENCODER_RIGHT"), -3.1);
+        display.AddData(std::string("EV_POS_DISP"), 42);
+        display.AddData(std::string("EV_POS"), 100 * 42 / 60);
+        display.AddData(std::string("INTAKE_ARMS_CLOSED"), false);
+        display.AddData(std::string("CONTAINER_GRABBER_CLOSED"), true);
+        display.SendToDS();
+    }
+}
+
+}  // namespace
+
+BENCHMARK(AddDataV1) { AddValues(V1Display(), state); }
+
+BENCHMARK(AddDataV1StringKeys) { AddValuesStringKeys(V1Display(), state); }
+
+BENCHMARK(AddDataV2) { AddValues(V2Display(), state); }
+
+BENCHMARK(AddDataV2StringKeys) { AddValuesStringKeys(V2Display(), state); }
+
+// Sends every value each time, like a version 1 packet
+BENCHMARK(AddDataV2Keyframes) {
+    auto& display = V2Display();
+    display.SetDeltaMode(false);
+    AddValues(display, state);
+    display.SetDeltaMode(true);
+}
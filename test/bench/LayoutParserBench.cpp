@@ -0,0 +1,64 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#include <string>
+
+#include "Benchmark.hpp"
+#include "DSDisplay/GuiSettings.hpp"
+#include "LayoutParser.hpp"
+
+namespace {
+
+// Returns a GUISettings.txt with 5,000 elements on ten pages
+std::string MakeLayout() {
+    std::string text;
+    for (int i = 0; i < 5000; i++) {
+        if (i % 500 == 0) {
+            text += "PAGE \"Page " + std::to_string(i / 500) + "\"\n";
+        }
+
+        auto key = "KEY_" + std::to_string(i);
+        switch (i % 4) {
+            case 0:
+                text += "TEXT " + key + " left \"" + key + ": 0\" \"" + key +
+                        ": %.2f\"\n";
+                break;
+            case 1:
+                text += "PBAR " + key + "_DISP, " + key + " right \"RPM " +
+                        "\\u2192 0\" \"RPM \\u2192 %s\"\n";
+                break;
+            case 2:
+                text += "STATUSLIGHT " + key + " right \"Arms Closed\" " +
+                        "\"Arms Closed\"\r\n";
+                break;
+            case 3:
+                text += "TEXT " + key + " left \"Gyro: 0\\u00b0\" " +
+                        "\"Gyro: %s\\u00b0\"\n\n";
+                break;
+        }
+    }
+    return text;
+}
+
+}  // namespace
+
+BENCHMARK(ParseLayout5000) {
+    auto text = MakeLayout();
+
+    // Reused like MainWindow's parser, so its vectors keep their capacity
+    LayoutParser parser;
+    for (size_t i = 0; i < state.iterations; i++) {
+        parser.parse(text);
+        bench::DoNotOptimize(parser.getElements().data());
+    }
+    state.bytes = text.size();
+}
+
+BENCHMARK(ParseKeys5000) {
+    auto text = MakeLayout();
+
+    for (size_t i = 0; i < state.iterations; i++) {
+        auto keys = GuiSettings::parseKeys(text);
+        bench::DoNotOptimize(keys.data());
+    }
+    state.bytes = text.size();
+}
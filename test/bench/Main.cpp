@@ -0,0 +1,83 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+
+#include "Benchmark.hpp"
+
+namespace {
+
+struct Entry {
+    const char* name;
+    bench::Function function;
+};
+
+std::vector<Entry>& Registry() {
+    static std::vector<Entry> registry;
+    return registry;
+}
+
+std::atomic<size_t> gAllocations{0};
+
+}  // namespace
+
+// Count every heap allocation so benchmarks can report allocations per call
+void* operator new(size_t size) {
+    gAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
+bench::Registration::Registration(const char* name, Function function) {
+    Registry().push_back({name, function});
+}
+
+int main(int argc, char* argv[]) {
+    using namespace std::chrono;
+    using clock = steady_clock;
+
+    // Only run benchmarks whose name contains the given text
+    const char* filter = argc > 1 ? argv[1] : "";
+
+    std::printf("%-36s %12s %12s %10s\n", "Benchmark", "ns/op", "allocs/op",
+                "bytes/op");
+
+    for (const auto& entry : Registry()) {
+        if (std::strstr(entry.name, filter) == nullptr) {
+            continue;
+        }
+
+        bench::State state;
+        state.iterations = 1;
+
+        while (true) {
+            size_t allocations = gAllocations.load();
+            auto start = clock::now();
+            entry.function(state);
+            auto elapsed = clock::now() - start;
+            allocations = gAllocations.load() - allocations;
+
+            if (elapsed >= milliseconds(200) || state.iterations >= 1u << 30) {
+                double ns = duration<double, std::nano>(elapsed).count();
+                std::printf("%-36s %12.1f %12.2f %10zu\n", entry.name,
+                            ns / state.iterations,
+                            static_cast<double>(allocations) / state.iterations,
+                            state.bytes);
+                break;
+            }
+
+            state.iterations *= 2;
+        }
+    }
+}
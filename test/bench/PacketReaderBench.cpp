@@ -0,0 +1,122 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#include <stdint.h>
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "DSDisplay/Protocol.hpp"
+#include "PacketReader.hpp"
+
+using namespace Protocol;
+
+namespace {
+
+constexpr size_t kEntries = 32;
+
+/* Builds the body of a version 1 Display packet with kEntries int32 values.
+ * The keys are long enough that a std::string copy allocates.
+ */
+std::vector<char> MakeV1Packet() {
+    std::vector<char> data;
+
+    for (size_t i = 0; i < kEntries; i++) {
+        std::string key = "SubsystemSensorValue" + std::to_string(i);
+
+        size_t pos = data.size();
+        data.resize(pos + 1 + 4 + key.size() + 4);
+        data[pos] = static_cast<char>(ValueType::Int32);
+        writeU32(&data[pos + 1], key.size());
+        key.copy(&data[pos + 5], key.size());
+        writeU32(&data[pos + 5 + key.size()], i);
+    }
+
+    return data;
+}
+
+/* Copies of the display's packetToVar() from before PacketReader, with
+ * qFromBigEndian() replaced by an equivalent loop so Qt isn't needed. Storing
+ * the values in the value table is measured in ValueTableBench.
+ */
+template <class T>
+bool packetToVar(const std::vector<char>& data, size_t& pos, T& dest) {
+    if (pos + sizeof(T) <= data.size()) {
+        std::make_unsigned_t<T> value = 0;
+        for (size_t i = 0; i < sizeof(T); i++) {
+            value = value << 8 | static_cast<uint8_t>(data[pos + i]);
+        }
+        dest = static_cast<T>(value);
+        pos += sizeof(dest);
+
+        return true;
+    } else {
+        return false;
+    }
+}
+
+bool packetToVar(const std::vector<char>& data, size_t& pos,
+                 std::string& dest) {
+    if (pos + sizeof(uint32_t) <= data.size()) {
+        uint32_t size;
+        packetToVar(data, pos, size);
+
+        if (pos + size <= data.size()) {
+            dest.assign(&data[pos], size);
+            pos += size;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+}  // namespace
+
+BENCHMARK(DecodeV1PacketStringView) {
+    auto data = MakeV1Packet();
+
+    for (size_t i = 0; i < state.iterations; i++) {
+        PacketReader reader(data);
+        while (!reader.atEnd()) {
+            reader.read<uint8_t>();
+            auto key = reader.readString();
+            bench::DoNotOptimize(key);
+            bench::DoNotOptimize(reader.read<int32_t>());
+        }
+    }
+    state.bytes = data.size();
+}
+
+// The decoder the display used before PacketReader, which copied each key
+BENCHMARK(DecodeV1PacketStringCopy) {
+    auto data = MakeV1Packet();
+
+    for (size_t i = 0; i < state.iterations; i++) {
+        size_t pos = 0;
+        uint8_t type;
+        std::string key;
+
+        while (pos < data.size() && packetToVar(data, pos, type) &&
+               packetToVar(data, pos, key)) {
+            bench::DoNotOptimize(key);
+
+            if (type == 'c') {
+                uint8_t value = 0;
+                packetToVar(data, pos, value);
+                bench::DoNotOptimize(value);
+            } else if (type == 'i') {
+                int32_t value = 0;
+                packetToVar(data, pos, value);
+                bench::DoNotOptimize(value);
+            } else if (type == 's') {
+                std::string value;
+                packetToVar(data, pos, value);
+                bench::DoNotOptimize(value);
+            }
+        }
+    }
+    state.bytes = data.size();
+}
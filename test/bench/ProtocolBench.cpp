@@ -0,0 +1,42 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#include "Benchmark.hpp"
+#include "DSDisplay/Protocol.hpp"
+
+using namespace Protocol;
+
+namespace {
+
+void EncodeHeader(bench::State& state, uint8_t version) {
+    char buf[kMaxHeaderSize];
+
+    for (size_t i = 0; i < state.iterations; i++) {
+        state.bytes = encodeHeader(buf, version, Opcode::Display);
+        bench::DoNotOptimize(buf);
+    }
+}
+
+void DecodeHeader(bench::State& state, uint8_t version) {
+    char buf[kMaxHeaderSize];
+    size_t size = encodeHeader(buf, version, Opcode::Display);
+
+    for (size_t i = 0; i < state.iterations; i++) {
+        bench::DoNotOptimize(buf);
+
+        size_t pos = 0;
+        Header header;
+        decodeHeader(buf, size, pos, header);
+        bench::DoNotOptimize(header);
+    }
+    state.bytes = size;
+}
+
+}  // namespace
+
+BENCHMARK(EncodeHeaderV1) { EncodeHeader(state, kVersion1); }
+
+BENCHMARK(EncodeHeaderV2) { EncodeHeader(state, kVersion2); }
+
+BENCHMARK(DecodeHeaderV1) { DecodeHeader(state, kVersion1); }
+
+BENCHMARK(DecodeHeaderV2) { DecodeHeader(state, kVersion2); }
@@ -0,0 +1,83 @@
+// Copyright (c) 2017-2018 FRC Team 3512. All Rights Reserved.
+
+#include <stdint.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "DSDisplay/Protocol.hpp"
+#include "Telemetry/Recorder.hpp"
+#include "Telemetry/TelemetryFormat.hpp"
+
+/* Records a packet of 32 doubles per iteration on the caller's thread, as the
+ * display does for each packet it receives
+ */
+
+namespace {
+
+constexpr size_t kValues = 32;
+
+std::vector<std::string> MakeKeys() {
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < kValues; i++) {
+        keys.emplace_back("SUBSYSTEM_SENSOR_" + std::to_string(i));
+    }
+    return keys;
+}
+
+std::string TempPath() {
+    return (std::filesystem::temp_directory_path() / "DSDisplayBench.dstl")
+        .string();
+}
+
+}  // namespace
+
+// Copies each key and value into a row, like Recorder used to
+BENCHMARK(RecordValuesRows) {
+    auto keys = MakeKeys();
+    char value[sizeof(double)] = {};
+    std::vector<TelemetryFormat::Row> rows;
+    rows.reserve(Recorder::kBlockRows);
+
+    for (size_t i = 0; i < state.iterations; i++) {
+        for (const auto& key : keys) {
+            rows.emplace_back();
+            auto& row = rows.back();
+            row.time = i;
+            row.key = key;
+            row.type = Protocol::ValueType::Double;
+            row.value.assign(value, sizeof(value));
+
+            if (rows.size() >= Recorder::kBlockRows) {
+                bench::DoNotOptimize(rows);
+                rows = std::vector<TelemetryFormat::Row>();
+                rows.reserve(Recorder::kBlockRows);
+            }
+        }
+    }
+}
+
+// Interns each key and appends the value to the block's buffer
+BENCHMARK(RecordValuesRecorder) {
+    auto keys = MakeKeys();
+    char value[sizeof(double)] = {};
+    auto path = TempPath();
+
+    {
+        Recorder recorder(path);
+        recorder.addLayout("TEXT SUBSYSTEM_SENSOR_0 left");
+
+        for (size_t i = 0; i < state.iterations; i++) {
+            recorder.beginPacket();
+            for (const auto& key : keys) {
+                recorder.addValue(key, Protocol::ValueType::Double, value,
+                                  sizeof(value));
+            }
+        }
+    }
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,72 @@
+// Copyright (c) 2017-2018 FRC Team 3512. All Rights Reserved.
+
+#include <codecvt>
+#include <locale>
+#include <string>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "Util.hpp"
+
+namespace {
+
+constexpr size_t kValues = 32;
+
+/* String values of a string-heavy packet. Most are ASCII, and every fourth
+ * has a degree sign.
+ */
+std::vector<std::string> MakeValues() {
+    std::vector<std::string> values;
+
+    for (size_t i = 0; i < kValues; i++) {
+        std::string value = "Autonomous step " + std::to_string(i);
+        if (i % 4 == 0) {
+            value += " heading 90°";
+        }
+        values.emplace_back(std::move(value));
+    }
+
+    return values;
+}
+
+size_t TotalSize(const std::vector<std::string>& values) {
+    size_t size = 0;
+    for (const auto& value : values) {
+        size += value.size();
+    }
+    return size;
+}
+
+}  // namespace
+
+// Converts each value like NetWidget::updateValues() did before
+BENCHMARK(ConvertStringsWstringConvert) {
+    auto values = MakeValues();
+
+    for (size_t i = 0; i < state.iterations; i++) {
+        for (const auto& value : values) {
+            std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
+            auto result = converter.from_bytes(value);
+            bench::DoNotOptimize(result);
+        }
+    }
+    state.bytes = TotalSize(values);
+}
+
+/* Decodes each value into a buffer reused between updates, like NetWidget
+ * does for the text of each widget
+ */
+BENCHMARK(ConvertStringsDecodeUtf8) {
+    auto values = MakeValues();
+    std::vector<std::u16string> buffers(values.size());
+
+    for (size_t i = 0; i < state.iterations; i++) {
+        for (size_t j = 0; j < values.size(); j++) {
+            auto& buffer = buffers[j];
+            buffer.resize(values[j].size());
+            buffer.resize(decodeUtf8(values[j], buffer.data()));
+            bench::DoNotOptimize(buffer);
+        }
+    }
+    state.bytes = TotalSize(values);
+}
@@ -0,0 +1,102 @@
+// Copyright (c) 2017-2018 FRC Team 3512. All Rights Reserved.
+
+#include <stdint.h>
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include "Benchmark.hpp"
+
+/* Compares the value tables NetWidget has used with 500 keys. Each iteration
+ * stores a value for every key, as a packet does, then reads every key, as
+ * the elements do when they update.
+ */
+
+namespace {
+
+using NetEntry = std::variant<int32_t, double, std::string>;
+
+constexpr size_t kKeys = 500;
+
+std::vector<std::string> MakeKeys() {
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < kKeys; i++) {
+        keys.emplace_back("SUBSYSTEM_SENSOR_" + std::to_string(i));
+    }
+    return keys;
+}
+
+}  // namespace
+
+// The std::map NetWidget used to look every key up in by name
+BENCHMARK(ValueTableMap500) {
+    auto keys = MakeKeys();
+    std::map<std::string, NetEntry> values;
+
+    for (size_t i = 0; i < state.iterations; i++) {
+        for (size_t j = 0; j < kKeys; j++) {
+            values[keys[j]] = static_cast<int32_t>(i + j);
+        }
+
+        int32_t sum = 0;
+        for (const auto& key : keys) {
+            sum += std::get<int32_t>(values[key]);
+        }
+        bench::DoNotOptimize(sum);
+    }
+}
+
+/* The slot table with version 1 packets, which still look each received key
+ * up by name to find its slot
+ */
+BENCHMARK(ValueTableSlotsByName500) {
+    auto keys = MakeKeys();
+    std::vector<NetEntry> slots(kKeys);
+    std::unordered_map<std::string, uint32_t> slotIndices;
+    std::vector<uint32_t> varSlots;
+    for (size_t j = 0; j < kKeys; j++) {
+        slotIndices.emplace(keys[j], j);
+        varSlots.push_back(j);
+    }
+
+    for (size_t i = 0; i < state.iterations; i++) {
+        for (size_t j = 0; j < kKeys; j++) {
+            auto slot = slotIndices.find(keys[j]);
+            if (slot != slotIndices.end()) {
+                slots[slot->second] = static_cast<int32_t>(i + j);
+            }
+        }
+
+        int32_t sum = 0;
+        for (auto slot : varSlots) {
+            sum += std::get<int32_t>(slots[slot]);
+        }
+        bench::DoNotOptimize(sum);
+    }
+}
+
+// The slot table with version 2 packets, which refer to keys by ID
+BENCHMARK(ValueTableSlotsById500) {
+    std::vector<NetEntry> slots(kKeys);
+    std::vector<uint32_t> keyIdTable;
+    std::vector<uint32_t> varSlots;
+    for (size_t j = 0; j < kKeys; j++) {
+        keyIdTable.push_back(j);
+        varSlots.push_back(j);
+    }
+
+    for (size_t i = 0; i < state.iterations; i++) {
+        for (uint16_t id = 0; id < kKeys; id++) {
+            slots[keyIdTable[id]] = static_cast<int32_t>(i + id);
+        }
+
+        int32_t sum = 0;
+        for (auto slot : varSlots) {
+            sum += std::get<int32_t>(slots[slot]);
+        }
+        bench::DoNotOptimize(sum);
+    }
+}
@@ -0,0 +1,69 @@
+// Copyright (c) 2017-2018 FRC Team 3512. All Rights Reserved.
+
+#include <string>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "NetWidgets/NetWidget.hpp"
+
+namespace {
+
+constexpr size_t kWidgets = 32;
+
+// Formats values without displaying them
+class Label : public NetWidget {
+public:
+    Label() : NetWidget(false) {}
+
+    void updateEntry() override {}
+};
+
+/* Two string values for each widget of a string-heavy packet, so every
+ * update changes the text. Every fourth has a degree sign.
+ */
+std::vector<NetWidget::NetEntry> MakeValues() {
+    std::vector<NetWidget::NetEntry> values;
+
+    for (size_t i = 0; i < 2 * kWidgets; i++) {
+        std::string value = "Autonomous step " + std::to_string(i);
+        if (i % 4 == 0) {
+            value += " heading 90\xc2\xb0";
+        }
+        values.emplace_back(std::move(value));
+    }
+
+    return values;
+}
+
+}  // namespace
+
+BENCHMARK(FillEntryStrings) {
+    auto values = MakeValues();
+    std::vector<Label> labels(kWidgets);
+    for (auto& label : labels) {
+        label.setUpdateText(L"Status: %s");
+    }
+
+    for (size_t i = 0; i < state.iterations; i++) {
+        for (size_t j = 0; j < kWidgets; j++) {
+            const auto& value = values[2 * j + i % 2];
+            bench::DoNotOptimize(labels[j].fillEntry(value));
+        }
+    }
+}
+
+BENCHMARK(FillRunsStrings) {
+    auto values = MakeValues();
+    std::vector<Label> labels(kWidgets);
+    std::vector<std::vector<QString>> runs(kWidgets);
+    for (auto& label : labels) {
+        label.setUpdateText(L"Status: %s");
+    }
+
+    for (size_t i = 0; i < state.iterations; i++) {
+        for (size_t j = 0; j < kWidgets; j++) {
+            labels[j].fillRuns(values[2 * j + i % 2], runs[j]);
+            bench::DoNotOptimize(runs[j]);
+        }
+    }
+}
@@ -0,0 +1,27 @@
+QT       += core gui widgets
+
+TARGET = QtBenchmarks
+TEMPLATE = app
+CONFIG += c++1z console release
+CONFIG -= app_bundle
+
+# Benchmarks of the display's widgets, which need Qt unlike those in ../bench
+DEFINES += NDEBUG
+
+INCLUDEPATH += ../../host ../../src ../bench
+
+SOURCES += \
+    ../bench/Main.cpp \
+    NetWidgetBench.cpp \
+    TextBench.cpp \
+    ../../src/PacketReader.cpp \
+    ../../src/Util.cpp \
+    ../../src/NetWidgets/NetWidget.cpp \
+    ../../src/NetWidgets/Text.cpp \
+    ../../src/NetWidgets/TimeSeries.cpp \
+    ../../src/Telemetry/Recorder.cpp
+
+HEADERS  += \
+    ../bench/Benchmark.hpp \
+    ../../src/NetWidgets/NetWidget.hpp \
+    ../../src/NetWidgets/Text.hpp
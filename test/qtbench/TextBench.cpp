@@ -0,0 +1,95 @@
+// Copyright (c) 2017-2018 FRC Team 3512. All Rights Reserved.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <QApplication>
+#include <QLabel>
+#include <QVBoxLayout>
+#include <QWidget>
+
+#include "Benchmark.hpp"
+#include "NetWidgets/Text.hpp"
+
+/* Updates 100 numeric labels per iteration, then processes the resulting
+ * layout and paint events. Set QT_QPA_PLATFORM to run on a real display
+ * instead of offscreen.
+ */
+
+namespace {
+
+constexpr int kLabels = 100;
+
+void StartApplication() {
+    static int argc = 1;
+    static char name[] = "QtBenchmarks";
+    static char* argv[] = {name, nullptr};
+
+    if (QApplication::instance() == nullptr) {
+        if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+            qputenv("QT_QPA_PLATFORM", "offscreen");
+        }
+        // Lives until the program exits
+        new QApplication(argc, argv);
+    }
+}
+
+// A value which changes every iteration and sometimes changes width
+double Value(size_t iteration, int label) {
+    return (iteration * 7 + label * 13) % 2000 / 10.0;
+}
+
+}  // namespace
+
+// Formats each value and sets it on a QLabel, like Text used to
+BENCHMARK(UpdateLabelsQLabel) {
+    StartApplication();
+
+    QWidget window;
+    auto layout = new QVBoxLayout(&window);
+    std::vector<QLabel*> labels;
+    for (int i = 0; i < kLabels; i++) {
+        labels.push_back(new QLabel(&window));
+        layout->addWidget(labels.back());
+    }
+    window.show();
+    QApplication::processEvents();
+
+    for (size_t i = 0; i < state.iterations; i++) {
+        for (int j = 0; j < kLabels; j++) {
+            labels[j]->setText(QString::fromStdWString(
+                L"Value: " + std::to_wstring(Value(i, j))));
+        }
+        QApplication::processEvents();
+    }
+}
+
+// Updates Text elements, which repaint only the run of the changed value
+BENCHMARK(UpdateLabelsText) {
+    StartApplication();
+
+    QWidget window;
+    auto layout = new QVBoxLayout(&window);
+    std::vector<Text*> labels;
+    std::vector<std::string> keys;
+    for (int i = 0; i < kLabels; i++) {
+        keys.emplace_back("VALUE_" + std::to_string(i));
+        std::vector<std::string> elementKeys{keys.back()};
+
+        labels.push_back(new Text(false, &window));
+        labels.back()->updateKeys(elementKeys);
+        labels.back()->setUpdateText(L"Value: %5.1f");
+        layout->addWidget(labels.back());
+    }
+    window.show();
+    QApplication::processEvents();
+
+    for (size_t i = 0; i < state.iterations; i++) {
+        for (int j = 0; j < kLabels; j++) {
+            NetWidget::setEntry(keys[j], Value(i, j));
+            labels[j]->updateEntry();
+        }
+        QApplication::processEvents();
+    }
+}
@@ -34,6 +34,9 @@ int main() {
     dsDisplay.AddAutoMethod("Auto 3", std::bind(&Robot::initFunc3, &robot),
                             std::bind(&Robot::periodicFunc3, &robot));
 
+    auto gyroVal = dsDisplay.RegisterKey<double>("GYRO_VAL");
+    auto armsClosed = dsDisplay.RegisterKey<bool>("ARMS_CLOSED");
+
     auto lastTime = std::chrono::steady_clock::now();
     auto currentTime = lastTime;
 
@@ -49,9 +52,9 @@ int main() {
             dsDisplay.AddData("ENCODER_RIGHT", -3.1);
             dsDisplay.AddData("EV_POS_DISP", 42);
             dsDisplay.AddData("EV_POS", 100 * 42 / 60);
-            dsDisplay.AddData("GYRO_VAL", 30.4);
+            dsDisplay.Set(gyroVal, 30.4);
 
-            dsDisplay.AddData("ARMS_CLOSED", true);
+            dsDisplay.Set(armsClosed, true);
             dsDisplay.AddData("INTAKE_ARMS_CLOSED", false);
             dsDisplay.AddData("CONTAINER_GRABBER_CLOSED", true);
 
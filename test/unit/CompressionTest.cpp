@@ -0,0 +1,102 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "DSDisplay/Compression.hpp"
+#include "UnitTest.hpp"
+
+namespace {
+
+// Returns true if data survives compression and decompression unchanged
+bool RoundTrips(const std::string& data) {
+    auto compressed = Compression::compress(data.data(), data.size());
+
+    std::string out(data.size(), '\0');
+    return Compression::decompress(compressed.data(), compressed.size(),
+                                   &out[0], out.size()) &&
+           out == data;
+}
+
+// Returns deterministic bytes which don't compress
+std::string RandomBytes(size_t size) {
+    std::string data(size, '\0');
+    uint32_t state = 12345;
+    for (auto& c : data) {
+        state = state * 1103515245 + 12345;
+        c = static_cast<char>(state >> 16);
+    }
+    return data;
+}
+
+std::string RepeatedLines(size_t count) {
+    std::string data;
+    for (size_t i = 0; i < count; i++) {
+        data += "TEXT KEY_" + std::to_string(i % 50) +
+                " left \"Value: \" \"Value: %s\"\n";
+    }
+    return data;
+}
+
+}  // namespace
+
+TEST(CompressionRoundTripsEmptyInput) { CHECK(RoundTrips("")); }
+
+TEST(CompressionRoundTripsShortInput) {
+    // Shorter than a match, so it's all literals
+    CHECK(RoundTrips("a"));
+    CHECK(RoundTrips("abc"));
+}
+
+TEST(CompressionRoundTripsRepetitiveText) {
+    auto data = RepeatedLines(500);
+    CHECK(RoundTrips(data));
+
+    auto compressed = Compression::compress(data.data(), data.size());
+    CHECK(compressed.size() < data.size() / 4);
+}
+
+TEST(CompressionRoundTripsIncompressibleData) {
+    CHECK(RoundTrips(RandomBytes(5000)));
+}
+
+TEST(CompressionRoundTripsLongRuns) {
+    // Lengths above 15 + 255 need several extra length bytes
+    CHECK(RoundTrips(std::string(100000, 'a')));
+    CHECK(RoundTrips(RandomBytes(1000) + std::string(600, 'b')));
+}
+
+TEST(DecompressRejectsWrongOutputSize) {
+    auto data = RepeatedLines(20);
+    auto compressed = Compression::compress(data.data(), data.size());
+
+    std::string shorter(data.size() - 1, '\0');
+    CHECK(!Compression::decompress(compressed.data(), compressed.size(),
+                                   &shorter[0], shorter.size()));
+
+    std::string longer(data.size() + 1, '\0');
+    CHECK(!Compression::decompress(compressed.data(), compressed.size(),
+                                   &longer[0], longer.size()));
+}
+
+TEST(DecompressRejectsTruncatedInput) {
+    // Ends in literals, so every byte of the stream adds output
+    auto data = RepeatedLines(20) + "xyz!";
+    auto compressed = Compression::compress(data.data(), data.size());
+
+    std::string out(data.size(), '\0');
+    for (size_t size = 0; size < compressed.size(); size++) {
+        CHECK(!Compression::decompress(compressed.data(), size, &out[0],
+                                       out.size()));
+    }
+}
+
+TEST(DecompressRejectsOffsetBeforeStart) {
+    // One literal, then a match reaching two bytes back
+    const char data[] = {0x10, 'a', 0x02, 0x00};
+
+    char out[5];
+    CHECK(!Compression::decompress(data, sizeof(data), out, sizeof(out)));
+}
@@ -0,0 +1,472 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#include <stdint.h>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "DSDisplay/DSDisplay.hpp"
+#include "DSDisplay/Protocol.hpp"
+#include "DSDisplay/Schema.hpp"
+#include "DSDisplay/UdpSocket.hpp"
+#include "PacketReader.hpp"
+#include "UnitTest.hpp"
+
+using namespace std::chrono_literals;
+using Protocol::ValueType;
+
+namespace {
+
+using Ids = std::vector<uint16_t>;
+
+constexpr uint16_t kRobotPort = 5812;
+constexpr uint32_t kLoopback = 0x7F000001;
+
+// How long to wait for the robot's answer before failing the test
+constexpr auto kTimeout = 1s;
+
+// Key IDs are A = 0, B = 1, and C = 2
+constexpr auto kLayout = Schema::MakeLayout(
+    Schema::Text<int32_t>("A", Schema::kLeft, "A: 0", "A: %d"),
+    Schema::Text<double>("B", Schema::kLeft, "B: 0", "B: %.1f"),
+    Schema::Text<Schema::String<8>>("C", Schema::kRight, "C:", "C: %s"));
+
+// Numbers the keys differently and adds D, which kLayout doesn't have
+constexpr auto kOtherLayout = Schema::MakeLayout(
+    Schema::Text<Schema::String<8>>("C", Schema::kRight, "C:", "C: %s"),
+    Schema::Text<int32_t>("D", Schema::kLeft, "D: 0", "D: %d"),
+    Schema::Text<int32_t>("A", Schema::kLeft, "A: 0", "A: %d"));
+
+/* Constructs a robot without its message about autonMode.txt. Like robot
+ * code, it has an autonomous mode, which answering Connect requires.
+ */
+std::unique_ptr<DSDisplay> MakeRobot() {
+    auto buf = std::cout.rdbuf(nullptr);
+    auto robot = std::make_unique<DSDisplay>(kRobotPort);
+    std::cout.rdbuf(buf);
+
+    robot->SetLayout<kLayout>();
+    robot->AddAutoMethod("Idle", [] {}, [] {});
+    return robot;
+}
+
+struct Entry {
+    ValueType type = ValueType::Char;
+    uint16_t id = 0;
+
+    // Value in wire encoding, without the length prefix strings have
+    std::string value;
+};
+
+// A decoded version 2 Display message
+struct DisplayMessage {
+    uint8_t version = 0;
+    uint8_t flags = 0;
+    uint32_t sequence = 0;
+    uint32_t sendTime = 0;
+    std::vector<Entry> entries;
+
+    bool IsKeyframe() const { return flags & Protocol::kKeyframe; }
+
+    Ids GetIds() const {
+        Ids ids;
+        for (const auto& entry : entries) {
+            ids.emplace_back(entry.id);
+        }
+        return ids;
+    }
+};
+
+/**
+ * Stands in for the display at the other end of a loopback connection
+ */
+class FakeDisplay {
+public:
+    FakeDisplay() : m_buffer(UdpSocket::kMaxDatagramSize) {
+        m_socket.bind(UdpSocket::kAnyPort);
+        m_socket.setBlocking(false);
+    }
+
+    /**
+     * Offers the given version in a Connect command and waits for the robot
+     * to answer it.
+     *
+     * AutonConfirmed is the robot's last reply, so the robot's next packet is
+     * encoded for this connection once it arrives.
+     */
+    bool Connect(uint8_t version) {
+        char data[Protocol::kMaxHeaderSize];
+        size_t size = Protocol::encodeCommand(data, Protocol::kVersion1,
+                                              Protocol::Opcode::Connect);
+        data[size - 1] = static_cast<char>(version);
+        m_socket.send(data, size, kLoopback, kRobotPort);
+
+        return Receive(Protocol::Opcode::AutonConfirmed);
+    }
+
+    /**
+     * Waits for the next message with the given opcode, skipping others such
+     * as keepalives.
+     *
+     * On success, the message's body is left for Read().
+     */
+    bool Receive(Protocol::Opcode opcode) {
+        auto deadline = std::chrono::steady_clock::now() + kTimeout;
+        while (std::chrono::steady_clock::now() < deadline) {
+            uint32_t address;
+            uint16_t port;
+            if (m_socket.receive(m_buffer.data(), m_buffer.size(), m_size,
+                                 address, port) != UdpSocket::Done) {
+                std::this_thread::sleep_for(1ms);
+                continue;
+            }
+
+            Protocol::Header header;
+            m_pos = 0;
+            if (Protocol::decodeHeader(m_buffer.data(), m_size, m_pos,
+                                       header) &&
+                header.opcode == opcode) {
+                m_version = header.version;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * Waits for the next Display message and decodes it
+     */
+    bool ReceiveDisplay(DisplayMessage& message) {
+        if (!Receive(Protocol::Opcode::Display)) {
+            return false;
+        }
+
+        PacketReader reader = Read();
+        message.version = m_version;
+        message.flags = reader.read<uint8_t>();
+        message.sequence = reader.read<uint32_t>();
+        message.sendTime = reader.read<uint32_t>();
+
+        message.entries.clear();
+        while (!reader.atEnd()) {
+            Entry entry;
+            entry.type = static_cast<ValueType>(reader.read<uint8_t>());
+            entry.id = reader.read<uint16_t>();
+
+            if (entry.type == ValueType::String) {
+                entry.value = reader.readString();
+            } else {
+                size_t size = entry.type == ValueType::Int32    ? 4
+                              : entry.type == ValueType::Double ? 8
+                                                                : 1;
+                entry.value.assign(reader.data() + reader.position(),
+                                   reader.remaining() < size ? 0 : size);
+                reader.skip(size);
+            }
+
+            message.entries.emplace_back(entry);
+        }
+
+        return reader.ok();
+    }
+
+    // Returns a reader for the body of the last received message
+    PacketReader Read() const {
+        return PacketReader(m_buffer.data(), m_size, m_pos);
+    }
+
+private:
+    UdpSocket m_socket;
+    std::vector<char> m_buffer;
+    size_t m_size = 0;
+    size_t m_pos = 0;
+    uint8_t m_version = 0;
+};
+
+int32_t Int32(const Entry& entry) {
+    return Protocol::readU32(entry.value.data());
+}
+
+double Double(const Entry& entry) {
+    return Protocol::readF64(entry.value.data());
+}
+
+}  // namespace
+
+TEST(DSDisplayDeltasHoldChangedSlotsInOrder) {
+    auto robot = MakeRobot();
+    robot->SetKeyframeInterval(1h);
+
+    FakeDisplay display;
+    REQUIRE(display.Connect(Protocol::kVersion2));
+
+    DisplayMessage message;
+    robot->AddData("A", 1);
+    robot->AddData("B", 2.0);
+    robot->AddData("C", "x");
+    robot->SendToDS();
+    REQUIRE(display.ReceiveDisplay(message));
+    CHECK(message.IsKeyframe());
+    CHECK(message.GetIds() == (Ids{0, 1, 2}));
+
+    // Only C and A changed, and they're sent in the order they changed
+    robot->AddData("C", "y");
+    robot->AddData("B", 2.0);
+    robot->AddData("A", 5);
+    robot->SendToDS();
+    REQUIRE(display.ReceiveDisplay(message));
+    CHECK(!message.IsKeyframe());
+    REQUIRE(message.GetIds() == (Ids{2, 0}));
+    CHECK(message.entries[0].type == ValueType::String);
+    CHECK(message.entries[0].value == "y");
+    CHECK(message.entries[1].type == ValueType::Int32);
+    CHECK(Int32(message.entries[1]) == 5);
+
+    // A slot changed more than once is sent once with its latest value
+    robot->AddData("B", 3.0);
+    robot->AddData("B", 4.0);
+    robot->SendToDS();
+    REQUIRE(display.ReceiveDisplay(message));
+    REQUIRE(message.GetIds() == (Ids{1}));
+    CHECK(Double(message.entries[0]) == 4.0);
+
+    robot->SendToDS();
+    REQUIRE(display.ReceiveDisplay(message));
+    CHECK(!message.IsKeyframe());
+    CHECK(message.entries.empty());
+
+    CHECK(robot->GetBandwidthStats().bytesSaved > 0);
+}
+
+TEST(DSDisplaySendsKeyframesAtTheInterval) {
+    auto robot = MakeRobot();
+    robot->SetKeyframeInterval(1h);
+
+    FakeDisplay display;
+    REQUIRE(display.Connect(Protocol::kVersion2));
+
+    DisplayMessage message;
+    robot->AddData("A", 1);
+    robot->AddData("B", 2.0);
+    robot->SendToDS();
+    REQUIRE(display.ReceiveDisplay(message));
+    CHECK(message.IsKeyframe());
+
+    robot->AddData("A", 2);
+    robot->SendToDS();
+    REQUIRE(display.ReceiveDisplay(message));
+    CHECK(!message.IsKeyframe());
+    CHECK(message.GetIds() == (Ids{0}));
+
+    // Keyframes hold every value, changed or not
+    robot->RequestKeyframe();
+    robot->SendToDS();
+    REQUIRE(display.ReceiveDisplay(message));
+    CHECK(message.IsKeyframe());
+    CHECK(message.GetIds() == (Ids{0, 1}));
+
+    robot->SetKeyframeInterval(100ms);
+    robot->SendToDS();
+    REQUIRE(display.ReceiveDisplay(message));
+    CHECK(!message.IsKeyframe());
+
+    std::this_thread::sleep_for(110ms);
+    robot->SendToDS();
+    REQUIRE(display.ReceiveDisplay(message));
+    CHECK(message.IsKeyframe());
+    CHECK(message.GetIds() == (Ids{0, 1}));
+
+    // Without delta mode, every packet is a keyframe
+    robot->SetDeltaMode(false);
+    robot->SendToDS();
+    REQUIRE(display.ReceiveDisplay(message));
+    CHECK(message.IsKeyframe());
+    CHECK(message.GetIds() == (Ids{0, 1}));
+}
+
+TEST(DSDisplaySendsKeyframeOnReconnect) {
+    auto robot = MakeRobot();
+    robot->SetKeyframeInterval(1h);
+
+    FakeDisplay display;
+    REQUIRE(display.Connect(Protocol::kVersion2));
+
+    DisplayMessage message;
+    robot->AddData("A", 1);
+    robot->AddData("B", 2.0);
+    robot->SendToDS();
+    REQUIRE(display.ReceiveDisplay(message));
+
+    robot->AddData("B", 3.0);
+    robot->SendToDS();
+    REQUIRE(display.ReceiveDisplay(message));
+    CHECK(!message.IsKeyframe());
+
+    // The reconnected display has none of the values, even unchanged ones
+    REQUIRE(display.Connect(Protocol::kVersion2));
+    robot->AddData("A", 1);
+    robot->AddData("B", 3.0);
+    robot->SendToDS();
+    REQUIRE(display.ReceiveDisplay(message));
+    CHECK(message.IsKeyframe());
+    CHECK(message.GetIds() == (Ids{0, 1}));
+}
+
+TEST(DSDisplayHeaderHasSequenceAndSendTime) {
+    auto start = std::chrono::steady_clock::now();
+    auto robot = MakeRobot();
+
+    FakeDisplay display;
+    REQUIRE(display.Connect(Protocol::kVersion2));
+
+    DisplayMessage first;
+    robot->AddData("A", 1);
+    robot->SendToDS();
+    REQUIRE(display.ReceiveDisplay(first));
+    CHECK(first.version == Protocol::kVersion2);
+
+    std::this_thread::sleep_for(5ms);
+
+    DisplayMessage second;
+    robot->AddData("A", 2);
+    robot->SendToDS();
+    REQUIRE(display.ReceiveDisplay(second));
+
+    // Send times are microseconds since the robot started
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    CHECK(second.sequence == first.sequence + 1);
+    CHECK(second.sendTime >= first.sendTime + 5000);
+    CHECK(second.sendTime <= elapsed.count());
+}
+
+TEST(DSDisplayHandlesFollowKeyTableChanges) {
+    auto robot = MakeRobot();
+    auto c = robot->RegisterKey<std::string>("C");
+    auto d = robot->RegisterKey<int32_t>("D");
+
+    FakeDisplay display;
+    REQUIRE(display.Connect(Protocol::kVersion2));
+
+    DisplayMessage message;
+    robot->Set(c, "x");
+    robot->Set(d, 1);
+    robot->SendToDS();
+    REQUIRE(display.ReceiveDisplay(message));
+    CHECK(message.GetIds() == (Ids{2}));
+
+    // Handles registered after the table arrived are resolved right away
+    auto a = robot->RegisterKey<int32_t>("A");
+    robot->Set(a, 5);
+    robot->SendToDS();
+    REQUIRE(display.ReceiveDisplay(message));
+    CHECK(message.GetIds() == (Ids{0}));
+
+    // A new table renumbers C and A and gives D an ID
+    robot->SetLayout<kOtherLayout>();
+    REQUIRE(display.Connect(Protocol::kVersion2));
+    robot->Set(a, 5);
+    robot->Set(c, "x");
+    robot->Set(d, 1);
+    robot->SendToDS();
+    REQUIRE(display.ReceiveDisplay(message));
+    CHECK(message.GetIds() == (Ids{0, 1, 2}));
+}
+
+TEST(DSDisplayIgnoresHandlesForMissingKeys) {
+    auto robot = MakeRobot();
+    auto missing = robot->RegisterKey<double>("MISSING");
+    auto b = robot->RegisterKey<double>("B");
+
+    FakeDisplay display;
+    REQUIRE(display.Connect(Protocol::kVersion2));
+
+    DisplayMessage message;
+    robot->Set(missing, 1.0);
+    robot->SendToDS();
+    REQUIRE(display.ReceiveDisplay(message));
+    CHECK(message.entries.empty());
+
+    robot->Set(missing, 2.0);
+    robot->Set(b, 3.0);
+    robot->SendToDS();
+    REQUIRE(display.ReceiveDisplay(message));
+    CHECK(message.GetIds() == (Ids{1}));
+}
+
+TEST(DSDisplayTypedSetMarksSlotDirty) {
+    auto robot = MakeRobot();
+    robot->SetKeyframeInterval(1h);
+    auto a = robot->RegisterKey<int32_t>("A");
+    auto b = robot->RegisterKey<double>("B");
+
+    FakeDisplay display;
+    REQUIRE(display.Connect(Protocol::kVersion2));
+
+    DisplayMessage message;
+    robot->Set(a, 1);
+    robot->Set(b, 2.0);
+    robot->SendToDS();
+    REQUIRE(display.ReceiveDisplay(message));
+    CHECK(message.IsKeyframe());
+
+    robot->Set(b, 2.5);
+    robot->Set(a, 1);
+    robot->SendToDS();
+    REQUIRE(display.ReceiveDisplay(message));
+    CHECK(!message.IsKeyframe());
+    REQUIRE(message.GetIds() == (Ids{1}));
+    CHECK(message.entries[0].type == ValueType::Double);
+    CHECK(Double(message.entries[0]) == 2.5);
+
+    // Setting the value it already has doesn't mark the slot again
+    robot->Set(b, 2.5);
+    robot->SendToDS();
+    REQUIRE(display.ReceiveDisplay(message));
+    CHECK(message.entries.empty());
+}
+
+TEST(DSDisplaySendsRecordsAsEntriesBelowVersion4) {
+    constexpr auto kA = kLayout.Find<int32_t>("A");
+    constexpr auto kB = kLayout.Find<double>("B");
+    constexpr auto kC = kLayout.Find<Schema::String<8>>("C");
+
+    auto robot = MakeRobot();
+
+    FakeDisplay display;
+    REQUIRE(display.Connect(Protocol::kVersion3));
+
+    Schema::Record<kLayout> record;
+    record.Set(kA, 7);
+    record.Set(kB, 1.5);
+    record.Set(kC, "on");
+    robot->SendToDS(record);
+
+    // Each field arrives as if it had been passed to AddData()
+    DisplayMessage message;
+    REQUIRE(display.ReceiveDisplay(message));
+    CHECK(message.version == Protocol::kVersion3);
+    REQUIRE(message.GetIds() == (Ids{0, 1, 2}));
+    CHECK(message.entries[0].type == ValueType::Int32);
+    CHECK(Int32(message.entries[0]) == 7);
+    CHECK(message.entries[1].type == ValueType::Double);
+    CHECK(Double(message.entries[1]) == 1.5);
+    CHECK(message.entries[2].type == ValueType::String);
+    CHECK(message.entries[2].value == "on");
+
+    // Version 4 displays receive the record itself
+    REQUIRE(display.Connect(Protocol::kVersion4));
+    robot->SendToDS(record);
+    REQUIRE(display.Receive(Protocol::Opcode::Record));
+
+    auto reader = display.Read();
+    reader.skip(sizeof(uint8_t) + 2 * sizeof(uint32_t));
+    REQUIRE(reader.remaining() == record.Size());
+    CHECK(std::string(reader.data() + reader.position(), record.Size()) ==
+          std::string(record.Data(), record.Size()));
+}
@@ -0,0 +1,232 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "DSDisplay/Compression.hpp"
+#include "DSDisplay/Protocol.hpp"
+#include "FragmentAssembler.hpp"
+#include "UnitTest.hpp"
+
+namespace {
+
+struct Fragment {
+    Protocol::FragmentHeader header;
+    std::string data;
+};
+
+// Splits a transfer into fragments the way the robot does
+std::vector<Fragment> Split(const std::string& body, uint16_t transferId,
+                            bool compress = false) {
+    std::string payload = body;
+    Protocol::FragmentHeader header;
+    header.transferId = transferId;
+    header.rawSize = body.size();
+
+    if (compress) {
+        auto compressed = Compression::compress(body.data(), body.size());
+        payload.assign(compressed.begin(), compressed.end());
+        header.flags = Protocol::kCompressed;
+    }
+    header.transferSize = payload.size();
+
+    // An empty transfer is still sent as one empty fragment
+    size_t count = (payload.size() + Protocol::kFragmentSize - 1) /
+                   Protocol::kFragmentSize;
+    header.count = count > 0 ? count : 1;
+
+    std::vector<Fragment> fragments;
+    for (uint16_t i = 0; i < header.count; i++) {
+        header.index = i;
+        fragments.push_back(
+            {header, payload.substr(i * Protocol::kFragmentSize,
+                                    Protocol::kFragmentSize)});
+    }
+    return fragments;
+}
+
+bool Add(FragmentAssembler& assembler, const Fragment& fragment) {
+    return assembler.add(fragment.header, fragment.data.data(),
+                         fragment.data.size());
+}
+
+std::string Take(FragmentAssembler& assembler) {
+    std::vector<char> body;
+    if (!assembler.take(body)) {
+        return "<take failed>";
+    }
+    return std::string(body.begin(), body.end());
+}
+
+std::string Body(size_t size) {
+    std::string body(size, '\0');
+    for (size_t i = 0; i < size; i++) {
+        body[i] = static_cast<char>('a' + i % 23);
+    }
+    return body;
+}
+
+}  // namespace
+
+TEST(FragmentHeaderRoundTrips) {
+    Protocol::FragmentHeader header;
+    header.transferId = 0x1234;
+    header.index = 2;
+    header.count = 3;
+    header.flags = Protocol::kCompressed;
+    header.transferSize = 2 * Protocol::kFragmentSize + 1;
+    header.rawSize = 100000;
+
+    char buf[Protocol::kFragmentHeaderSize];
+    Protocol::encodeFragmentHeader(buf, header);
+
+    size_t pos = 0;
+    Protocol::FragmentHeader decoded;
+    REQUIRE(Protocol::decodeFragmentHeader(buf, sizeof(buf), pos, decoded));
+    CHECK(pos == sizeof(buf));
+    CHECK(decoded.transferId == header.transferId);
+    CHECK(decoded.index == header.index);
+    CHECK(decoded.count == header.count);
+    CHECK(decoded.flags == header.flags);
+    CHECK(decoded.transferSize == header.transferSize);
+    CHECK(decoded.rawSize == header.rawSize);
+
+    // A count which doesn't match the size is rejected
+    header.count = 4;
+    Protocol::encodeFragmentHeader(buf, header);
+    pos = 0;
+    CHECK(!Protocol::decodeFragmentHeader(buf, sizeof(buf), pos, decoded));
+}
+
+TEST(FragmentAssemblerReassemblesInOrder) {
+    auto body = Body(3 * Protocol::kFragmentSize + 17);
+    auto fragments = Split(body, 1);
+    REQUIRE(fragments.size() == 4);
+
+    FragmentAssembler assembler;
+    for (size_t i = 0; i + 1 < fragments.size(); i++) {
+        CHECK(!Add(assembler, fragments[i]));
+    }
+    CHECK(Add(assembler, fragments.back()));
+    CHECK(Take(assembler) == body);
+    CHECK(!assembler.isActive());
+}
+
+TEST(FragmentAssemblerReassemblesOutOfOrder) {
+    auto body = Body(4 * Protocol::kFragmentSize);
+    auto fragments = Split(body, 2);
+
+    FragmentAssembler assembler;
+    CHECK(!Add(assembler, fragments[3]));
+    CHECK(!Add(assembler, fragments[0]));
+    CHECK(!Add(assembler, fragments[2]));
+    CHECK(Add(assembler, fragments[1]));
+    CHECK(Take(assembler) == body);
+}
+
+TEST(FragmentAssemblerIgnoresDuplicates) {
+    auto body = Body(2 * Protocol::kFragmentSize + 1);
+    auto fragments = Split(body, 3);
+
+    FragmentAssembler assembler;
+    CHECK(!Add(assembler, fragments[1]));
+    CHECK(!Add(assembler, fragments[1]));
+    CHECK(!Add(assembler, fragments[0]));
+    CHECK(!Add(assembler, fragments[0]));
+    CHECK(Add(assembler, fragments[2]));
+    CHECK(Take(assembler) == body);
+
+    // Late duplicates of the completed transfer don't restart it
+    CHECK(!Add(assembler, fragments[0]));
+    CHECK(!assembler.isActive());
+
+    // Unless the display asked to receive it again
+    assembler.forgetCompleted();
+    CHECK(!Add(assembler, fragments[0]));
+    CHECK(assembler.isActive());
+}
+
+TEST(FragmentAssemblerReportsMissingFragments) {
+    auto fragments = Split(Body(5 * Protocol::kFragmentSize), 4);
+
+    FragmentAssembler assembler;
+    Add(assembler, fragments[0]);
+    Add(assembler, fragments[2]);
+    Add(assembler, fragments[4]);
+
+    CHECK(assembler.missing(10) == (std::vector<uint16_t>{1, 3}));
+    CHECK(assembler.missing(1) == (std::vector<uint16_t>{1}));
+
+    // An incomplete transfer can't be taken
+    std::vector<char> body;
+    CHECK(!assembler.take(body));
+    CHECK(assembler.isActive());
+
+    // Resent fragments complete it
+    CHECK(!Add(assembler, fragments[3]));
+    CHECK(Add(assembler, fragments[1]));
+    CHECK(assembler.missing(10).empty());
+}
+
+TEST(FragmentAssemblerRestartsOnNewTransfer) {
+    auto oldFragments = Split(Body(3 * Protocol::kFragmentSize), 5);
+    auto body = Body(2 * Protocol::kFragmentSize);
+    auto newFragments = Split(body, 6);
+
+    FragmentAssembler assembler;
+    Add(assembler, oldFragments[0]);
+    Add(assembler, oldFragments[1]);
+
+    CHECK(!Add(assembler, newFragments[1]));
+    CHECK(assembler.transferId() == 6);
+    CHECK(assembler.missing(10) == (std::vector<uint16_t>{0}));
+    CHECK(Add(assembler, newFragments[0]));
+    CHECK(Take(assembler) == body);
+}
+
+TEST(FragmentAssemblerRejectsMismatchedFragments) {
+    auto fragments = Split(Body(2 * Protocol::kFragmentSize + 5), 7);
+
+    FragmentAssembler assembler;
+    Add(assembler, fragments[0]);
+
+    // Wrong length for its index
+    auto shortened = fragments[1];
+    shortened.data.pop_back();
+    CHECK(!Add(assembler, shortened));
+
+    // Disagrees with the transfer's shape
+    auto reshaped = fragments[1];
+    reshaped.header.rawSize++;
+    CHECK(!Add(assembler, reshaped));
+
+    CHECK(assembler.missing(10) == (std::vector<uint16_t>{1, 2}));
+}
+
+TEST(FragmentAssemblerDecompresses) {
+    std::string body;
+    for (int i = 0; i < 400; i++) {
+        body += "TEXT KEY_" + std::to_string(i) + " left \"\" \"\"\n";
+    }
+    auto fragments = Split(body, 8, true);
+    REQUIRE(fragments.size() > 1);
+    std::reverse(fragments.begin(), fragments.end());
+
+    FragmentAssembler assembler;
+    for (size_t i = 0; i < fragments.size(); i++) {
+        CHECK(Add(assembler, fragments[i]) == (i + 1 == fragments.size()));
+    }
+    CHECK(Take(assembler) == body);
+}
+
+TEST(FragmentAssemblerHandlesEmptyTransfer) {
+    auto fragments = Split("", 9);
+    REQUIRE(fragments.size() == 1);
+
+    FragmentAssembler assembler;
+    CHECK(Add(assembler, fragments[0]));
+    CHECK(Take(assembler).empty());
+}
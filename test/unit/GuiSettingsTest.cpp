@@ -0,0 +1,59 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#include <string>
+#include <vector>
+
+#include "DSDisplay/GuiSettings.hpp"
+#include "LayoutParser.hpp"
+#include "UnitTest.hpp"
+
+using Keys = std::vector<std::string>;
+
+TEST(ParseKeysSkipsSpacesAfterCommas) {
+    CHECK(GuiSettings::parseKeys("TEXT A, B left \"A\" \"B\"") ==
+          (Keys{"A", "B"}));
+}
+
+TEST(ParseKeysTreatsTabsAndCarriageReturnsAsSpaces) {
+    CHECK(GuiSettings::parseKeys("TEXT\tA,\tB\tleft \"\" \"\"\r\n"
+                                 "GRAPH C\r\n") == (Keys{"A", "B", "C"}));
+}
+
+TEST(ParseKeysSkipsPagesAndDuplicates) {
+    CHECK(GuiSettings::parseKeys("PAGE \"Drive\"\n"
+                                 "TEXT A,B left \"\" \"\"\n"
+                                 "\n"
+                                 "PBAR B,C right \"\" \"\"") ==
+          (Keys{"A", "B", "C"}));
+}
+
+TEST(ParseKeysMatchesLayoutParser) {
+    const char* text =
+        "TEXT A, B left \"\" \"\"\n"
+        "STATUSLIGHT\tC,D\tright \"\" \"\"\r\n"
+        "PAGE \"Second\"\n"
+        "GRAPH E,  F left \"\" \"\"\n";
+
+    LayoutParser parser;
+    REQUIRE(parser.parse(text));
+
+    Keys layoutKeys;
+    for (const auto& element : parser.getElements()) {
+        layoutKeys.insert(layoutKeys.end(), element.keys.begin(),
+                          element.keys.end());
+    }
+    CHECK(GuiSettings::parseKeys(text) == layoutKeys);
+}
+
+TEST(ParseKeysSkipsRunsOfWhitespaceInKeyLists) {
+    const char* text =
+        "  GRAPH \t A,  \tB,\t\t C  \tleft \"\" \"\"\r\n"
+        "\tTEXT\t\tD \t right \"\" \"\"\r\n";
+
+    LayoutParser parser;
+    REQUIRE(parser.parse(text));
+    REQUIRE(parser.getElements().size() == 2);
+    CHECK(parser.getElements()[0].keys == (Keys{"A", "B", "C"}));
+    CHECK(parser.getElements()[1].keys == (Keys{"D"}));
+    CHECK(GuiSettings::parseKeys(text) == (Keys{"A", "B", "C", "D"}));
+}
@@ -0,0 +1,177 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#include <string>
+#include <vector>
+
+#include "LayoutParser.hpp"
+#include "UnitTest.hpp"
+#include "Util.hpp"
+
+TEST(FormatSpecScansPrintfSpecs) {
+    FormatSpec spec;
+    REQUIRE(scanFormatSpec(std::string_view{"a %-05.2f b"}, 2, spec));
+    CHECK(spec.end == 9);
+    CHECK(spec.supported);
+    CHECK(spec.width == 5);
+    CHECK(spec.precision == 2);
+    CHECK(spec.leftAlign);
+
+    REQUIRE(scanFormatSpec(std::wstring_view{L"%s"}, 0, spec));
+    CHECK(spec.end == 2);
+    CHECK(spec.supported);
+    CHECK(spec.width == 0);
+    CHECK(spec.precision == -1);
+    CHECK(!spec.leftAlign);
+
+    // Not specs
+    CHECK(!scanFormatSpec(std::string_view{"50%"}, 2, spec));
+    CHECK(!scanFormatSpec(std::string_view{"%q"}, 0, spec));
+    CHECK(!scanFormatSpec(std::string_view{"%5.2"}, 0, spec));
+}
+
+TEST(FormatSpecRejectsLongWidthAndPrecision) {
+    FormatSpec spec;
+    REQUIRE(scanFormatSpec(std::string_view{"%99.99f"}, 0, spec));
+    CHECK(spec.supported);
+
+    REQUIRE(scanFormatSpec(std::string_view{"%100d"}, 0, spec));
+    CHECK(spec.end == 5);
+    CHECK(!spec.supported);
+
+    REQUIRE(scanFormatSpec(std::wstring_view{L"%.100f"}, 0, spec));
+    CHECK(!spec.supported);
+}
+
+TEST(LayoutParserReportsUnsupportedFormatSpecs) {
+    LayoutParser parser;
+    CHECK(!parser.parse("TEXT A left \"\" \"%5d %%100d %100d\""));
+
+    // The element is kept and only the real spec is reported
+    CHECK(parser.getElements().size() == 1);
+    REQUIRE(parser.getErrors().size() == 1);
+    CHECK(parser.getErrors()[0].line == 1);
+    CHECK(parser.getErrors()[0].column == 28);
+}
+
+TEST(LayoutParserIgnoresSpecsOutsideUpdateText) {
+    LayoutParser parser;
+    CHECK(parser.parse("TEXT A left \"%100d\" \"50%%\""));
+    CHECK(parser.getErrors().empty());
+}
+
+TEST(LayoutParserParsesElementsAndPages) {
+    LayoutParser parser;
+    REQUIRE(parser.parse(
+        "TEXT SPEED left \"Speed: 0\" \"Speed: %s\"\r\n"
+        "\n"
+        "PAGE \"Climb \\u2191\"\n"
+        "\tPBAR RPM_DISP, RPM right \"RPM\" \"RPM: %s\"\n"
+        "GRAPH A,B left \"Title\" \"10\""));
+
+    const auto& elements = parser.getElements();
+    REQUIRE(elements.size() == 3);
+
+    CHECK(elements[0].type == ElementDesc::Type::Text);
+    CHECK(elements[0].column == ElementDesc::Column::Left);
+    CHECK(elements[0].keys == (std::vector<std::string>{"SPEED"}));
+    CHECK(elements[0].startText == L"Speed: 0");
+    CHECK(elements[0].updateText == L"Speed: %s");
+    CHECK(elements[0].page == 0);
+
+    CHECK(elements[1].type == ElementDesc::Type::ProgressBar);
+    CHECK(elements[1].column == ElementDesc::Column::Right);
+    CHECK(elements[1].keys == (std::vector<std::string>{"RPM_DISP", "RPM"}));
+    CHECK(elements[1].page == 1);
+
+    CHECK(elements[2].type == ElementDesc::Type::Graph);
+    CHECK(elements[2].page == 1);
+
+    // Elements before the first PAGE line are on an unnamed page
+    CHECK(parser.getPages() ==
+          (std::vector<std::wstring>{L"", L"Climb \u2191"}));
+}
+
+TEST(LayoutParserDecodesUtf8AndEscapes) {
+    LayoutParser parser;
+    REQUIRE(parser.parse("TEXT A left \"Gyro: 0\\u00b0\" "
+                         "\"\xc2\xb0 \xe2\x86\x92\""));
+
+    const auto& element = parser.getElements().at(0);
+    CHECK(element.startText == L"Gyro: 0\u00b0");
+    CHECK(element.updateText == L"\u00b0 \u2192");
+}
+
+namespace {
+
+// Returns the single error reported for the text, or line 0 if there isn't one
+LayoutParser::Error ParseError(const char* text) {
+    LayoutParser parser;
+    parser.parse(text);
+    if (parser.getErrors().size() != 1) {
+        return {};
+    }
+    return parser.getErrors()[0];
+}
+
+}  // namespace
+
+TEST(LayoutParserReportsErrorPositions) {
+    struct Case {
+        const char* text;
+        size_t line;
+        size_t column;
+    };
+
+    const Case cases[] = {
+        // Unknown element type
+        {"TEXT A left \"\" \"\"\n  LABEL A left \"\" \"\"", 2, 3},
+
+        // Empty key after a comma
+        {"TEXT A, ,B left \"\" \"\"", 1, 9},
+        {"TEXT A,,B left \"\" \"\"", 1, 8},
+
+        // Missing key list
+        {"TEXT", 1, 5},
+
+        // Bad column
+        {"\n\nTEXT A middle \"\" \"\"", 3, 8},
+
+        // Missing quotes
+        {"TEXT A left Speed \"\"", 1, 13},
+        {"TEXT A left \"Speed\"", 1, 20},
+        {"TEXT A left \"Speed \"\"", 1, 21},
+
+        // Bad escape
+        {"TEXT A left \"\\u00g0\" \"\"", 1, 14},
+        {"TEXT A left \"\\u00\"", 1, 14},
+    };
+
+    for (const auto& test : cases) {
+        auto error = ParseError(test.text);
+        if (error.line != test.line || error.column != test.column) {
+            unit::Fail(__FILE__, __LINE__,
+                       std::string(test.text) + " reported " +
+                           std::to_string(error.line) + ":" +
+                           std::to_string(error.column) + " (" +
+                           error.message + ")");
+        }
+    }
+}
+
+TEST(LayoutParserSkipsOnlyMalformedLines) {
+    LayoutParser parser;
+    CHECK(!parser.parse("TEXT A left \"\" \"\"\n"
+                        "TEXT B sideways \"\" \"\"\n"
+                        "TEXT C right \"\" \"\""));
+
+    const auto& elements = parser.getElements();
+    REQUIRE(elements.size() == 2);
+    CHECK(elements[0].keys[0] == "A");
+    CHECK(elements[1].keys[0] == "C");
+    CHECK(parser.getErrors().size() == 1);
+
+    // Parsing again replaces the previous results
+    CHECK(parser.parse("TEXT D left \"\" \"\""));
+    CHECK(parser.getElements().size() == 1);
+    CHECK(parser.getErrors().empty());
+}
@@ -0,0 +1,189 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#include <stdint.h>
+
+#include <chrono>
+#include <cmath>
+
+#include "LinkStats.hpp"
+#include "UnitTest.hpp"
+
+using namespace std::chrono_literals;
+using steady_clock = std::chrono::steady_clock;
+
+namespace {
+
+bool Near(double a, double b) { return std::abs(a - b) < 1e-9; }
+
+// Robot sends a packet every 20 ms
+constexpr uint32_t kPeriodUs = 20000;
+
+}  // namespace
+
+TEST(LinkStatsHasNoJitterForSteadyArrivals) {
+    LinkStats stats;
+    auto start = steady_clock::now();
+
+    for (uint32_t i = 0; i < 50; i++) {
+        CHECK(stats.addPacket(i, i * kPeriodUs, 100, start + i * 20ms));
+    }
+    stats.tick();
+
+    CHECK(Near(stats.summary().jitter, 0.0));
+    CHECK(Near(stats.summary().lossPercent, 0.0));
+}
+
+TEST(LinkStatsEstimatesJitterPerRfc3550) {
+    LinkStats stats;
+    auto start = steady_clock::now();
+
+    stats.addPacket(0, 0, 100, start);
+
+    // Arrives 4 ms late: J += (|D| - J) / 16 with D = 4000 us
+    stats.addPacket(1, kPeriodUs, 100, start + 24ms);
+    CHECK(Near(stats.summary().jitter, 4.0 / 16));
+
+    // Arrives on time, so D = -4000 us relative to the late packet
+    stats.addPacket(2, 2 * kPeriodUs, 100, start + 40ms);
+    double jitter = 4.0 / 16 + (4.0 - 4.0 / 16) / 16;
+    CHECK(Near(stats.summary().jitter, jitter));
+
+    // The interval records the jitter at its end
+    stats.tick();
+    stats.tick();
+    CHECK(Near(stats.summary().jitter, jitter));
+}
+
+TEST(LinkStatsCountsLoss) {
+    LinkStats stats;
+    auto start = steady_clock::now();
+
+    CHECK(stats.addPacket(0, 0, 100, start));
+    CHECK(stats.addPacket(1, kPeriodUs, 100, start + 20ms));
+    CHECK(stats.addPacket(4, 4 * kPeriodUs, 100, start + 80ms));
+    stats.tick();
+
+    // Two of five packets were lost
+    auto summary = stats.summary();
+    CHECK(Near(summary.lossPercent, 40.0));
+    CHECK(summary.reordered == 0);
+}
+
+TEST(LinkStatsCountsReorderedPackets) {
+    LinkStats stats;
+    auto start = steady_clock::now();
+
+    stats.addPacket(0, 0, 100, start);
+    stats.addPacket(2, 2 * kPeriodUs, 100, start + 40ms);
+
+    // The late packet is dropped and counted as reordered instead of lost
+    CHECK(!stats.addPacket(1, kPeriodUs, 100, start + 41ms));
+    stats.tick();
+
+    auto summary = stats.summary();
+    CHECK(summary.reordered == 1);
+    CHECK(Near(summary.lossPercent, 0.0));
+
+    // Reordered packets don't affect jitter
+    CHECK(Near(summary.jitter, 0.0));
+}
+
+TEST(LinkStatsCountsReorderingAcrossIntervals) {
+    LinkStats stats;
+    auto start = steady_clock::now();
+
+    stats.addPacket(1, kPeriodUs, 100, start);
+    stats.addPacket(3, 3 * kPeriodUs, 100, start + 40ms);
+    stats.tick();
+
+    // The gap was counted as lost in the previous interval
+    CHECK(!stats.addPacket(2, 2 * kPeriodUs, 100, start + 41ms));
+    stats.tick();
+
+    auto summary = stats.summary();
+    CHECK(summary.reordered == 1);
+    CHECK(Near(summary.lossPercent, 0.0));
+}
+
+TEST(LinkStatsCountsVeryLatePacketsAsLost) {
+    LinkStats stats;
+    auto start = steady_clock::now();
+
+    stats.addPacket(0, 0, 100, start);
+    for (uint32_t i = 2; i < 100; i++) {
+        stats.addPacket(i, i * kPeriodUs, 100, start + i * 20ms);
+    }
+
+    // Packet 1 fell out of the reorder window, so it stays lost
+    CHECK(!stats.addPacket(1, kPeriodUs, 100, start + 2s));
+    stats.tick();
+
+    auto summary = stats.summary();
+    CHECK(summary.reordered == 0);
+    CHECK(Near(summary.lossPercent, 1.0));
+}
+
+TEST(LinkStatsIgnoresDuplicates) {
+    LinkStats stats;
+    auto start = steady_clock::now();
+
+    stats.addPacket(0, 0, 100, start);
+    stats.addPacket(1, kPeriodUs, 100, start + 20ms);
+    CHECK(!stats.addPacket(1, kPeriodUs, 100, start + 21ms));
+    CHECK(!stats.addPacket(0, 0, 100, start + 22ms));
+    stats.tick();
+
+    auto summary = stats.summary();
+    CHECK(summary.reordered == 0);
+    CHECK(Near(summary.lossPercent, 0.0));
+}
+
+TEST(LinkStatsHandlesSequenceWraparound) {
+    LinkStats stats;
+    auto start = steady_clock::now();
+
+    CHECK(stats.addPacket(UINT32_MAX, 0, 100, start));
+    CHECK(stats.addPacket(0, kPeriodUs, 100, start + 20ms));
+    CHECK(stats.addPacket(1, 2 * kPeriodUs, 100, start + 40ms));
+    stats.tick();
+
+    CHECK(Near(stats.summary().lossPercent, 0.0));
+}
+
+TEST(LinkStatsRestartsWithRobot) {
+    LinkStats stats;
+    auto start = steady_clock::now();
+
+    stats.addPacket(5000, 0, 100, start);
+
+    // A sequence far behind the newest one means the robot restarted
+    CHECK(stats.addPacket(0, 0, 100, start + 20ms));
+    CHECK(stats.addPacket(1, kPeriodUs, 100, start + 40ms));
+    stats.tick();
+
+    auto summary = stats.summary();
+    CHECK(summary.reordered == 0);
+    CHECK(Near(summary.lossPercent, 0.0));
+}
+
+TEST(LinkStatsSummarizesRecentIntervals) {
+    LinkStats stats;
+    auto start = steady_clock::now();
+
+    // An interval with loss which falls out of the window
+    stats.addPacket(0, 0, 1000, start);
+    stats.addPacket(10, 0, 1000, start);
+    stats.tick();
+
+    uint32_t sequence = 11;
+    for (size_t i = 0; i < LinkStats::kWindowSize; i++) {
+        stats.addPacket(sequence++, 0, 100, start);
+        stats.addBytesSaved(50);
+        stats.tick();
+    }
+
+    auto summary = stats.summary();
+    CHECK(Near(summary.lossPercent, 0.0));
+    CHECK(Near(summary.bytesPerSecond, 100.0));
+    CHECK(Near(summary.savedPerSecond, 50.0));
+}
@@ -0,0 +1,58 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "UnitTest.hpp"
+
+namespace {
+
+struct Entry {
+    const char* name;
+    unit::Function function;
+};
+
+std::vector<Entry>& Registry() {
+    static std::vector<Entry> registry;
+    return registry;
+}
+
+size_t gFailures = 0;
+
+}  // namespace
+
+unit::Registration::Registration(const char* name, Function function) {
+    Registry().push_back({name, function});
+}
+
+void unit::Fail(const char* file, int line, const std::string& message) {
+    std::printf("%s:%d: check failed: %s\n", file, line, message.c_str());
+    gFailures++;
+}
+
+int main(int argc, char* argv[]) {
+    // Only run tests whose name contains the given text
+    const char* filter = argc > 1 ? argv[1] : "";
+
+    size_t failedTests = 0;
+    size_t testCount = 0;
+    for (const auto& entry : Registry()) {
+        if (std::strstr(entry.name, filter) == nullptr) {
+            continue;
+        }
+
+        size_t failures = gFailures;
+        entry.function();
+        testCount++;
+
+        if (gFailures != failures) {
+            std::printf("FAILED %s\n", entry.name);
+            failedTests++;
+        }
+    }
+
+    std::printf("%zu of %zu tests passed\n", testCount - failedTests,
+                testCount);
+    return failedTests == 0 ? 0 : 1;
+}
@@ -0,0 +1,94 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "DSDisplay/Protocol.hpp"
+#include "PacketReader.hpp"
+#include "UnitTest.hpp"
+
+TEST(PacketReaderReadsBigEndianIntegers) {
+    std::vector<char> data(1 + 2 + 4 + 8 + 4);
+    data[0] = static_cast<char>(0xAB);
+    Protocol::writeU16(&data[1], 0x1234);
+    Protocol::writeU32(&data[3], 0x89ABCDEF);
+    Protocol::writeU64(&data[7], 0x0102030405060708);
+    Protocol::writeU32(&data[15], static_cast<uint32_t>(-5));
+
+    PacketReader reader(data);
+    CHECK(reader.read<uint8_t>() == 0xAB);
+    CHECK(reader.read<uint16_t>() == 0x1234);
+    CHECK(reader.read<uint32_t>() == 0x89ABCDEF);
+    CHECK(reader.read<uint64_t>() == 0x0102030405060708);
+    CHECK(reader.read<int32_t>() == -5);
+    CHECK(reader.ok());
+    CHECK(reader.atEnd());
+}
+
+TEST(PacketReaderReadsStringsInPlace) {
+    std::string data(4, '\0');
+    Protocol::writeU32(&data[0], 5);
+    data += "hello!";
+
+    PacketReader reader(data.data(), data.size());
+    auto text = reader.readString();
+    CHECK(text == "hello");
+    CHECK(text.data() == data.data() + 4);
+    CHECK(reader.position() == 9);
+    CHECK(reader.remaining() == 1);
+    CHECK(!reader.atEnd());
+}
+
+TEST(PacketReaderFailsOnShortIntegers) {
+    std::vector<char> data(3);
+
+    PacketReader reader(data);
+    CHECK(reader.read<uint16_t>() == 0);
+    CHECK(reader.ok());
+
+    // One byte is left, so the read fails without advancing
+    CHECK(reader.read<uint16_t>() == 0);
+    CHECK(!reader.ok());
+    CHECK(reader.position() == 2);
+    CHECK(reader.atEnd());
+
+    // Later reads fail even if they would fit
+    CHECK(reader.read<uint8_t>() == 0);
+    CHECK(!reader.ok());
+    CHECK(reader.position() == 2);
+}
+
+TEST(PacketReaderFailsOnStringsLongerThanThePacket) {
+    std::string data(4, '\0');
+    Protocol::writeU32(&data[0], 0xFFFFFFFF);
+    data += "abc";
+
+    PacketReader reader(data.data(), data.size());
+    CHECK(reader.readString().empty());
+    CHECK(!reader.ok());
+    CHECK(reader.position() == 4);
+}
+
+TEST(PacketReaderFailsOnSkipPastTheEnd) {
+    std::vector<char> data(4);
+
+    PacketReader reader(data);
+    reader.skip(4);
+    CHECK(reader.ok());
+    CHECK(reader.atEnd());
+
+    reader.skip(1);
+    CHECK(!reader.ok());
+}
+
+TEST(PacketReaderFailsOnStartPastTheEnd) {
+    std::vector<char> data(4);
+
+    PacketReader reader(data, 5);
+    CHECK(!reader.ok());
+    CHECK(reader.position() == 4);
+    CHECK(reader.remaining() == 0);
+    CHECK(reader.readString().empty());
+}
@@ -0,0 +1,97 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#include <stdint.h>
+
+#include <cstring>
+#include <string>
+
+#include "DSDisplay/Packet.hpp"
+#include "DSDisplay/Protocol.hpp"
+#include "UnitTest.hpp"
+
+namespace {
+
+// Returns the packet's data as a string
+std::string Data(const Packet& packet) {
+    if (packet.getDataSize() == 0) {
+        return "";
+    }
+
+    return std::string(static_cast<const char*>(packet.getData()),
+                       packet.getDataSize());
+}
+
+}  // namespace
+
+TEST(PacketReserveDoesNotAddData) {
+    Packet packet;
+    packet.reserve(64);
+    CHECK(packet.getDataSize() == 0);
+    CHECK(packet.getData() == nullptr);
+
+    // Appends within the reserved size don't move the data
+    packet << static_cast<uint8_t>(1);
+    const void* data = packet.getData();
+    for (int i = 1; i < 64; i++) {
+        packet << static_cast<uint8_t>(1);
+    }
+    CHECK(packet.getDataSize() == 64);
+    CHECK(packet.getData() == data);
+}
+
+TEST(PacketAppendsUncheckedAfterReserve) {
+    Packet packet;
+    packet.append("ab", 2);
+    packet.reserve(packet.getDataSize() + 5);
+    packet.appendUnchecked("cd", 2);
+    packet.appendUnchecked("efg", 3);
+    CHECK(Data(packet) == "abcdefg");
+}
+
+TEST(PacketPatchesPlaceholdersBigEndian) {
+    Packet packet;
+    packet << static_cast<uint8_t>(0xAA);
+    size_t shortPos = packet.appendPlaceholder(sizeof(uint16_t));
+    size_t longPos = packet.appendPlaceholder(sizeof(uint32_t));
+    packet.append("xyz", 3);
+    CHECK(shortPos == 1);
+    CHECK(longPos == 3);
+    CHECK(packet.getDataSize() == 10);
+
+    packet.patch(shortPos, static_cast<uint16_t>(0x1234));
+    packet.patch(longPos, static_cast<uint32_t>(0x89ABCDEF));
+
+    auto data = Data(packet);
+    CHECK(static_cast<uint8_t>(data[0]) == 0xAA);
+    CHECK(Protocol::readU16(&data[1]) == 0x1234);
+    CHECK(static_cast<uint8_t>(data[1]) == 0x12);
+    CHECK(Protocol::readU32(&data[3]) == 0x89ABCDEF);
+    CHECK(static_cast<uint8_t>(data[3]) == 0x89);
+    CHECK(data.substr(7) == "xyz");
+}
+
+TEST(PacketWritesStringsWithBigEndianLength) {
+    Packet packet;
+    packet << std::string("hi");
+
+    auto data = Data(packet);
+    REQUIRE(data.size() == 6);
+    CHECK(Protocol::readU32(&data[0]) == 2);
+    CHECK(data.substr(4) == "hi");
+}
+
+TEST(PacketClearKeepsCapacity) {
+    Packet packet(16);
+    packet.append("0123456789abcdef", 16);
+    const void* data = packet.getData();
+
+    packet.clear();
+    CHECK(packet.getDataSize() == 0);
+    CHECK(packet.getData() == nullptr);
+
+    // Refilling to the same size reuses the buffer
+    packet.append("fedcba", 6);
+    packet.append("9876543210", 10);
+    CHECK(packet.getData() == data);
+    CHECK(Data(packet) == "fedcba9876543210");
+}
@@ -0,0 +1,130 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "DSDisplay/DSDisplay.hpp"
+#include "DSDisplay/GuiSettings.hpp"
+#include "DSDisplay/Protocol.hpp"
+#include "DSDisplay/Schema.hpp"
+#include "UnitTest.hpp"
+
+using Protocol::ValueType;
+
+namespace {
+
+constexpr auto kLayout = Schema::MakeLayout(
+    Schema::Text<int32_t>("COUNT", Schema::kLeft, "Count: 0", "Count: %d"),
+    Schema::StatusLight("READY", Schema::kRight, "Ready", "Ready"),
+    Schema::Page("Second"),
+    Schema::ProgressBar<double, int8_t>("SPEED", "FILL", Schema::kLeft,
+                                        "Speed: 0", "Speed: %.1f"),
+    Schema::Text<bool>("ENABLED", Schema::kRight, "Enabled", "Enabled"),
+    Schema::Text<Schema::String<4>>("MODE", Schema::kLeft, "Mode:",
+                                    "Mode: %s"),
+    Schema::Graph<double>({"SPEED", "RATE"}, Schema::kLeft, "Speed", "1000"));
+
+std::string GuiSettingsText() {
+    return std::string(Schema::kGuiSettings<kLayout>.data(),
+                       Schema::kGuiSettings<kLayout>.size());
+}
+
+}  // namespace
+
+TEST(SchemaGeneratesGuiSettings) {
+    CHECK(GuiSettingsText() ==
+          "TEXT COUNT left \"Count: 0\" \"Count: %d\"\n"
+          "STATUSLIGHT READY right \"Ready\" \"Ready\"\n"
+          "PAGE \"Second\"\n"
+          "PBAR SPEED,FILL left \"Speed: 0\" \"Speed: %.1f\"\n"
+          "TEXT ENABLED right \"Enabled\" \"Enabled\"\n"
+          "TEXT MODE left \"Mode:\" \"Mode: %s\"\n"
+          "GRAPH SPEED,RATE left \"Speed\" \"1000\"\n");
+}
+
+TEST(SchemaFieldsFollowParseKeys) {
+    const auto& fields = Schema::kFields<kLayout>;
+    auto keys = GuiSettings::parseKeys(GuiSettingsText());
+
+    // Field i is sent with key ID i, so both orders must agree
+    REQUIRE(fields.size() == keys.size());
+    for (size_t i = 0; i < fields.size(); i++) {
+        CHECK(fields[i].key == keys[i]);
+    }
+
+    // Fields are packed in key ID order with no padding
+    struct Expected {
+        ValueType type;
+        uint16_t offset;
+        uint16_t size;
+    };
+    std::vector<Expected> expected = {
+        {ValueType::Int32, 0, 4},   {ValueType::Char, 4, 1},
+        {ValueType::Double, 5, 8},  {ValueType::Char, 13, 1},
+        {ValueType::Char, 14, 1},   {ValueType::String, 15, 8},
+        {ValueType::Double, 23, 8}};
+    REQUIRE(fields.size() == expected.size());
+    for (size_t i = 0; i < fields.size(); i++) {
+        CHECK(fields[i].type == expected[i].type);
+        CHECK(fields[i].offset == expected[i].offset);
+        CHECK(fields[i].size == expected[i].size);
+    }
+    CHECK(kLayout.RecordSize() == 31);
+    CHECK(Schema::Record<kLayout>::Size() == 31);
+}
+
+TEST(SchemaRecordStartsInactive) {
+    Schema::Record<kLayout> record;
+    const char* data = record.Data();
+
+    CHECK(data[kLayout.Find<int8_t>("READY").offset] == DSDisplay::inactive);
+    CHECK(data[kLayout.Find<bool>("ENABLED").offset] == DSDisplay::inactive);
+    CHECK(data[kLayout.Find<int8_t>("FILL").offset] == 0);
+    CHECK(Protocol::readU32(data + kLayout.Find<int32_t>("COUNT").offset) ==
+          0);
+    CHECK(Protocol::readF64(data + kLayout.Find<double>("SPEED").offset) ==
+          0.0);
+    CHECK(Protocol::readU32(
+              data + kLayout.Find<Schema::String<4>>("MODE").offset) == 0);
+}
+
+TEST(SchemaRecordSetEncodesWireValues) {
+    constexpr auto kCount = kLayout.Find<int32_t>("COUNT");
+    constexpr auto kReady = kLayout.Find<int8_t>("READY");
+    constexpr auto kEnabled = kLayout.Find<bool>("ENABLED");
+    constexpr auto kRate = kLayout.Find<double>("RATE");
+    constexpr auto kMode = kLayout.Find<Schema::String<4>>("MODE");
+
+    Schema::Record<kLayout> record;
+    const char* data = record.Data();
+
+    record.Set(kCount, -2);
+    CHECK(Protocol::readU32(data + kCount.offset) ==
+          static_cast<uint32_t>(-2));
+    CHECK(static_cast<uint8_t>(data[kCount.offset]) == 0xFF);
+
+    record.Set(kReady, DSDisplay::standby);
+    CHECK(data[kReady.offset] == DSDisplay::standby);
+
+    record.Set(kEnabled, true);
+    CHECK(data[kEnabled.offset] == DSDisplay::active);
+    record.Set(kEnabled, false);
+    CHECK(data[kEnabled.offset] == DSDisplay::inactive);
+
+    record.Set(kRate, 1.5);
+    CHECK(Protocol::readF64(data + kRate.offset) == 1.5);
+
+    record.Set(kMode, "ab");
+    CHECK(Protocol::readU32(data + kMode.offset) == 2);
+    CHECK(std::string(data + kMode.offset + 4, 2) == "ab");
+
+    // Strings longer than the field are truncated to fit
+    record.Set(kMode, "abcdef");
+    CHECK(Protocol::readU32(data + kMode.offset) == 4);
+    CHECK(std::string(data + kMode.offset + 4, 4) == "abcd");
+
+    // Neighboring fields are untouched
+    CHECK(Protocol::readF64(data + kRate.offset) == 1.5);
+}
@@ -0,0 +1,394 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#include <stdint.h>
+#include <sys/stat.h>
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "DSDisplay/Protocol.hpp"
+#include "Telemetry/Reader.hpp"
+#include "Telemetry/Recorder.hpp"
+#include "Telemetry/TelemetryFormat.hpp"
+#include "UnitTest.hpp"
+
+using namespace std::chrono_literals;
+using Protocol::ValueType;
+using TelemetryFormat::Row;
+
+namespace {
+
+std::string Int32(int32_t value) {
+    std::string out(sizeof(uint32_t), '\0');
+    Protocol::writeU32(&out[0], value);
+    return out;
+}
+
+std::string Double(double value) {
+    std::string out(sizeof(double), '\0');
+    Protocol::writeF64(&out[0], value);
+    return out;
+}
+
+std::string String(const std::string& value) {
+    std::string out(sizeof(uint32_t), '\0');
+    Protocol::writeU32(&out[0], value.size());
+    return out + value;
+}
+
+std::vector<Row> SampleRows() {
+    return {{1000, "SPEED", ValueType::Double, Double(-3.25)},
+            {1000, "MODE", ValueType::String, String("Auto 1")},
+            {1000, "ARMS", ValueType::Char, std::string(1, '\x01')},
+            {21000, "COUNT", ValueType::Int32, Int32(-70000)},
+            {21000, "SPEED", ValueType::Double, Double(12.5)},
+            {41000, "COUNT", ValueType::Int32, Int32(INT32_MAX)},
+            {41000, "MODE", ValueType::String, String("")}};
+}
+
+bool RowsEqual(const std::vector<Row>& a, const std::vector<Row>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i].time != b[i].time || a[i].key != b[i].key ||
+            a[i].type != b[i].type || a[i].value != b[i].value) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Temporary file which is removed when the test ends
+class TempFile {
+public:
+    explicit TempFile(const char* name)
+        : m_path((std::filesystem::temp_directory_path() / name).string()) {}
+
+    ~TempFile() { std::remove(m_path.c_str()); }
+
+    const std::string& path() const { return m_path; }
+
+    void write(const std::string& contents) const {
+        std::ofstream file(m_path, std::ofstream::binary);
+        file << contents;
+    }
+
+private:
+    std::string m_path;
+};
+
+// Returns a file with a layout block followed by two data blocks
+std::string SampleFile() {
+    auto rows = SampleRows();
+    std::vector<Row> first(rows.begin(), rows.begin() + 3);
+    std::vector<Row> second(rows.begin() + 3, rows.end());
+
+    return TelemetryFormat::encodeFileHeader() +
+           TelemetryFormat::encodeBlock(
+               TelemetryFormat::BlockKind::Layout,
+               TelemetryFormat::encodeLayout(500, "TEXT SPEED left")) +
+           TelemetryFormat::encodeBlock(TelemetryFormat::BlockKind::Data,
+                                        TelemetryFormat::encodeData(first)) +
+           TelemetryFormat::encodeBlock(TelemetryFormat::BlockKind::Data,
+                                        TelemetryFormat::encodeData(second));
+}
+
+}  // namespace
+
+TEST(TelemetryVarintRoundTrips) {
+    for (uint64_t value : {uint64_t{0}, uint64_t{127}, uint64_t{128},
+                           uint64_t{300}, uint64_t{UINT32_MAX}, UINT64_MAX}) {
+        std::string out;
+        TelemetryFormat::writeVarint(out, value);
+
+        size_t pos = 0;
+        uint64_t decoded;
+        CHECK(TelemetryFormat::readVarint(out, pos, decoded));
+        CHECK(decoded == value);
+        CHECK(pos == out.size());
+
+        // A varint cut short is rejected
+        out.pop_back();
+        pos = 0;
+        CHECK(!TelemetryFormat::readVarint(out, pos, decoded));
+    }
+}
+
+TEST(TelemetryCrc32MatchesStandard) {
+    CHECK(TelemetryFormat::crc32("123456789", 9) == 0xCBF43926);
+    CHECK(TelemetryFormat::crc32("", 0) == 0);
+}
+
+TEST(TelemetryLayoutRoundTrips) {
+    auto payload = TelemetryFormat::encodeLayout(123456789, "TEXT A left");
+
+    uint64_t time;
+    std::string text;
+    REQUIRE(TelemetryFormat::decodeLayout(payload, time, text));
+    CHECK(time == 123456789);
+    CHECK(text == "TEXT A left");
+
+    CHECK(!TelemetryFormat::decodeLayout(payload.substr(0, 7), time, text));
+}
+
+TEST(TelemetryDataRoundTrips) {
+    auto rows = SampleRows();
+    auto payload = TelemetryFormat::encodeData(rows);
+
+    std::vector<Row> decoded;
+    REQUIRE(TelemetryFormat::decodeData(payload, decoded));
+    CHECK(RowsEqual(decoded, rows));
+
+    // Rows are appended to those already decoded
+    REQUIRE(TelemetryFormat::decodeData(payload, decoded));
+    CHECK(decoded.size() == 2 * rows.size());
+}
+
+TEST(TelemetryDataRoundTripsEmptyBlock) {
+    std::vector<Row> decoded;
+    CHECK(TelemetryFormat::decodeData(TelemetryFormat::encodeData({}),
+                                      decoded));
+    CHECK(decoded.empty());
+}
+
+TEST(TelemetryDataRejectsMalformedPayloads) {
+    auto payload = TelemetryFormat::encodeData(SampleRows());
+
+    for (size_t size = 0; size < payload.size(); size++) {
+        std::vector<Row> decoded;
+        CHECK(!TelemetryFormat::decodeData(payload.substr(0, size), decoded));
+    }
+
+    std::vector<Row> decoded;
+    CHECK(!TelemetryFormat::decodeData(payload + '\0', decoded));
+}
+
+TEST(TelemetryReaderReadsEveryBlock) {
+    TempFile file("DSDisplayReaderTest.dstl");
+    file.write(SampleFile());
+
+    Reader reader;
+    REQUIRE(reader.open(file.path()));
+    CHECK(!reader.isTruncated());
+
+    // The layout, then one display packet per distinct time
+    auto& packets = reader.getPackets();
+    REQUIRE(packets.size() == 4);
+    CHECK(packets[0].isLayout);
+    CHECK(packets[0].time == 500);
+    CHECK(!packets[1].isLayout);
+    CHECK(packets[1].time == 1000);
+    CHECK(packets[2].time == 21000);
+    CHECK(packets[3].time == 41000);
+
+    // Display packets use version 1 framing with named keys
+    const auto& data = packets[2].data;
+    size_t pos = 0;
+    Protocol::Header header;
+    REQUIRE(Protocol::decodeHeader(data.data(), data.size(), pos, header));
+    CHECK(header.version == Protocol::kVersion1);
+    CHECK(header.opcode == Protocol::Opcode::Display);
+
+    std::string expected = static_cast<char>(ValueType::Int32) +
+                           String("COUNT") + Int32(-70000) +
+                           static_cast<char>(ValueType::Double) +
+                           String("SPEED") + Double(12.5);
+    CHECK(std::string(data.begin() + pos, data.end()) == expected);
+}
+
+TEST(TelemetryReaderKeepsBlocksBeforeBadChecksum) {
+    auto contents = SampleFile();
+
+    // Corrupt the last byte of the final block's payload
+    contents.back() ^= 0x01;
+
+    TempFile file("DSDisplayReaderTest.dstl");
+    file.write(contents);
+
+    Reader reader;
+    REQUIRE(reader.open(file.path()));
+    CHECK(reader.isTruncated());
+    CHECK(reader.getPackets().size() == 2);
+}
+
+TEST(TelemetryReaderKeepsBlocksBeforeTruncation) {
+    auto contents = SampleFile();
+    size_t fullSize = contents.size();
+
+    TempFile file("DSDisplayReaderTest.dstl");
+
+    // Cut inside the final block's header and inside its payload
+    for (size_t cut : {size_t{4}, size_t{12}}) {
+        file.write(contents.substr(0, fullSize - cut));
+
+        Reader reader;
+        REQUIRE(reader.open(file.path()));
+        CHECK(reader.isTruncated());
+        CHECK(reader.getPackets().size() == 2);
+    }
+}
+
+TEST(TelemetryReaderRejectsOtherFiles) {
+    TempFile file("DSDisplayReaderTest.dstl");
+
+    Reader reader;
+    CHECK(!reader.open(file.path()));
+
+    file.write("DSTX");
+    CHECK(!reader.open(file.path()));
+
+    auto contents = SampleFile();
+    contents[sizeof(TelemetryFormat::kMagic)]++;
+    file.write(contents);
+    CHECK(!reader.open(file.path()));
+}
+
+TEST(TelemetryRecorderOutputIsReadable) {
+    TempFile file("DSDisplayRecorderTest.dstl");
+
+    {
+        Recorder recorder(file.path());
+        recorder.addLayout("TEXT SPEED left");
+
+        for (int i = 0; i < 3; i++) {
+            // Packets a few milliseconds apart don't share a time
+            std::this_thread::sleep_for(2ms);
+            recorder.beginPacket();
+
+            auto speed = Double(i);
+            recorder.addValue("SPEED", ValueType::Double, speed.data(),
+                              speed.size());
+        }
+    }
+
+    Reader reader;
+    REQUIRE(reader.open(file.path()));
+    CHECK(!reader.isTruncated());
+
+    auto& packets = reader.getPackets();
+    REQUIRE(packets.size() == 4);
+    CHECK(packets[0].isLayout);
+    for (size_t i = 1; i < packets.size(); i++) {
+        CHECK(!packets[i].isLayout);
+        CHECK(packets[i].time > packets[i - 1].time);
+    }
+}
+
+TEST(TelemetryRecorderKeepsKeysAcrossLayouts) {
+    TempFile file("DSDisplayRecorderKeysTest.dstl");
+    auto rows = SampleRows();
+
+    {
+        Recorder recorder(file.path());
+        recorder.addLayout("TEXT SPEED left");
+        for (size_t i = 0; i < 3; i++) {
+            recorder.addValue(rows[i].key, rows[i].type, rows[i].value.data(),
+                              rows[i].value.size());
+        }
+
+        // Keys are interned again for the new layout
+        recorder.addLayout("TEXT COUNT left");
+        for (size_t i = 3; i < rows.size(); i++) {
+            recorder.addValue(rows[i].key, rows[i].type, rows[i].value.data(),
+                              rows[i].value.size());
+        }
+    }
+
+    std::ifstream input(file.path(), std::ifstream::binary);
+    std::string contents{std::istreambuf_iterator<char>(input),
+                         std::istreambuf_iterator<char>()};
+
+    std::vector<Row> decoded;
+    size_t pos = TelemetryFormat::kFileHeaderSize;
+    while (pos + TelemetryFormat::kBlockHeaderSize <= contents.size()) {
+        auto kind = static_cast<TelemetryFormat::BlockKind>(contents[pos]);
+        size_t size = Protocol::readU32(&contents[pos + 1]);
+        if (kind == TelemetryFormat::BlockKind::Data) {
+            REQUIRE(TelemetryFormat::decodeData(
+                contents.substr(pos + TelemetryFormat::kBlockHeaderSize, size),
+                decoded));
+        }
+        pos += TelemetryFormat::kBlockHeaderSize + size;
+    }
+    CHECK(pos == contents.size());
+
+    // Times come from the recorder's clock, so only the rest is compared
+    for (auto& row : decoded) {
+        row.time = 0;
+    }
+    for (auto& row : rows) {
+        row.time = 0;
+    }
+    CHECK(RowsEqual(decoded, rows));
+}
+
+TEST(TelemetryRecorderKeepsLayoutsWhenQueueIsFull) {
+    TempFile pipe("DSDisplayRecorderPipe.dstl");
+    std::remove(pipe.path().c_str());
+    REQUIRE(mkfifo(pipe.path().c_str(), 0600) == 0);
+
+    std::string contents;
+    std::thread readThread;
+    size_t dropped;
+
+    {
+        // Opening the pipe blocks until it's read, stalling the writer
+        Recorder recorder(pipe.path());
+        recorder.addLayout("TEXT SPEED left");
+
+        auto speed = Double(1.0);
+        for (size_t i = 0; i < Recorder::kMaxQueuedBlocks + 8; i++) {
+            recorder.addValue("SPEED", ValueType::Double, speed.data(),
+                              speed.size());
+            recorder.flush();
+        }
+        recorder.addLayout("TEXT COUNT left");
+        dropped = recorder.getDroppedBlocks();
+
+        readThread = std::thread([&] {
+            std::ifstream input(pipe.path(), std::ifstream::binary);
+            contents.assign(std::istreambuf_iterator<char>(input),
+                            std::istreambuf_iterator<char>());
+        });
+    }
+    readThread.join();
+    CHECK(dropped > 0);
+
+    TempFile file("DSDisplayRecorderFullTest.dstl");
+    file.write(contents);
+
+    Reader reader;
+    REQUIRE(reader.open(file.path()));
+    CHECK(!reader.isTruncated());
+
+    auto& packets = reader.getPackets();
+    REQUIRE(!packets.empty());
+    CHECK(packets.back().isLayout);
+    const auto& data = packets.back().data;
+    CHECK(std::string(data.begin(), data.end()).find("TEXT COUNT left") !=
+          std::string::npos);
+}
+
+TEST(TelemetryRecorderReportsFailure) {
+    auto path = std::filesystem::temp_directory_path() /
+                "DSDisplayMissingDir" / "Recorder.dstl";
+    Recorder recorder(path.string());
+    CHECK(!recorder.hasFailed());
+
+    auto speed = Double(1.0);
+    recorder.addValue("SPEED", ValueType::Double, speed.data(), speed.size());
+    recorder.flush();
+
+    for (int i = 0; i < 1000 && !recorder.hasFailed(); i++) {
+        std::this_thread::sleep_for(1ms);
+    }
+    CHECK(recorder.hasFailed());
+    CHECK(recorder.getDroppedBlocks() == 0);
+}
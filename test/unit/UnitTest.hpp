@@ -0,0 +1,46 @@
+// Copyright (c) 2026 FRC Team 3512. All Rights Reserved.
+
+#pragma once
+
+#include <string>
+
+/**
+ * A minimal unit test runner
+ *
+ * TEST(Name) { ... } registers a test. CHECK(condition) records a failure
+ * with its file and line if the condition is false and lets the test
+ * continue. REQUIRE(condition) also returns from the test, for conditions
+ * the rest of the test depends on.
+ */
+namespace unit {
+
+using Function = void (*)();
+
+struct Registration {
+    Registration(const char* name, Function function);
+};
+
+// Records a failed check in the running test
+void Fail(const char* file, int line, const std::string& message);
+
+}  // namespace unit
+
+#define TEST(name)                                              \
+    static void name();                                         \
+    static unit::Registration name##Registration_(#name, name); \
+    static void name()
+
+#define CHECK(condition)                                \
+    do {                                                \
+        if (!(condition)) {                             \
+            unit::Fail(__FILE__, __LINE__, #condition); \
+        }                                               \
+    } while (0)
+
+#define REQUIRE(condition)                              \
+    do {                                                \
+        if (!(condition)) {                             \
+            unit::Fail(__FILE__, __LINE__, #condition); \
+            return;                                     \
+        }                                               \
+    } while (0)
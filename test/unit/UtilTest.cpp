@@ -0,0 +1,47 @@
+// Copyright (c) 2017-2018 FRC Team 3512. All Rights Reserved.
+
+#include <string>
+
+#include "UnitTest.hpp"
+#include "Util.hpp"
+
+namespace {
+
+std::u16string Decode(std::string_view text) {
+    std::u16string result(text.size(), u'\0');
+    result.resize(decodeUtf8(text, result.data()));
+    return result;
+}
+
+}  // namespace
+
+TEST(DecodeUtf8CopiesAscii) { CHECK(Decode("Gyro: 45") == u"Gyro: 45"); }
+
+TEST(DecodeUtf8DecodesMultibyteSequences) {
+    CHECK(Decode("90\xc2\xb0") == u"90°");
+    CHECK(Decode("\xe2\x82\xac") == u"€");
+}
+
+TEST(DecodeUtf8WritesSurrogatePairs) {
+    CHECK(Decode("\xf0\x9f\x98\x80") == u"\U0001F600");
+}
+
+TEST(DecodeUtf8ReplacesInvalidSequences) {
+    // Stray continuation byte
+    CHECK(Decode("a\x80z") == u"a\ufffdz");
+
+    // Truncated sequence
+    CHECK(Decode("a\xe2\x82") == u"a\ufffd");
+
+    // Overlong encoding of '/'
+    CHECK(Decode("\xc0\xaf") == u"\ufffd");
+
+    // Encoded surrogate
+    CHECK(Decode("\xed\xa0\x80") == u"\ufffd");
+}
+
+TEST(AppendUtf8AppendsToWideStrings) {
+    std::wstring text = L"Arm: ";
+    appendUtf8(text, "45\xc2\xb0");
+    CHECK(text == L"Arm: 45°");
+}